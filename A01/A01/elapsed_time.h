@@ -29,6 +29,24 @@ double cpu_time(void)
   return (double)current_time.tv_sec + 1.0e-9 * (double)current_time.tv_nsec;
 }
 
+double wall_time(void)
+{ // unlike cpu_time(), this does not add the time of all threads of the process
+  struct timespec current_time;
+
+  if(clock_gettime(CLOCK_MONOTONIC,&current_time) != 0)
+    return -1.0; // clock_gettime() failed!!!
+  return (double)current_time.tv_sec + 1.0e-9 * (double)current_time.tv_nsec;
+}
+
+double thread_cpu_time(void)
+{ // only the time of the calling thread
+  struct timespec current_time;
+
+  if(clock_gettime(CLOCK_THREAD_CPUTIME_ID,&current_time) != 0)
+    return -1.0; // clock_gettime() failed!!!
+  return (double)current_time.tv_sec + 1.0e-9 * (double)current_time.tv_nsec;
+}
+
 #endif
 
 
@@ -55,4 +73,14 @@ double cpu_time(void)
   return (double)current_time.QuadPart / (double)frequency.QuadPart;
 }
 
+double wall_time(void)
+{ // the performance counter already measures the elapsed (wall clock) time
+  return cpu_time();
+}
+
+double thread_cpu_time(void)
+{ // elapsed time (the other threads are not accounted for)
+  return cpu_time();
+}
+
 #endif
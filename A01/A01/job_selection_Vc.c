@@ -8,7 +8,8 @@
 //
 // Brute-force solution of the generalized weighted job selection problem
 //
-// Compile with "cc -Wall -O2 job_selection.c -lm" or equivalent
+// Compile with "cc -Wall -O2 -pthread job_selection.c -lm" or equivalent (the threads use POSIX threads, so on
+// Windows a MinGW compiler with winpthreads is needed)
 //
 // In the generalized weighted job selection problem we will solve here we have T programming tasks and P programmers.
 // Each programming task has a starting date (an integer), an ending date (another integer), and a profit (yet another
@@ -48,11 +49,32 @@
 //      Write a report explaining what you did. Do not forget to put all your code in an appendix.
 //
 
+#include <limits.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#ifdef _WIN32
+# include <direct.h>
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+#endif
+#if defined(SIMD_FIRST_IDLE) && defined(__AVX2__)
+# include <immintrin.h>
+# define FIRST_IDLE_LANES  8  // number of busy[] entries compared at once by first_idle()
+#elif defined(SIMD_FIRST_IDLE) && (defined(__SSE2__) || defined(_M_X64))
+# include <emmintrin.h>
+# define FIRST_IDLE_LANES  4
+#else
+# define FIRST_IDLE_LANES  1
+#endif
 #include "elapsed_time.h"
 
 
@@ -91,8 +113,13 @@ int rng_main() __attribute__((__unused__));   // gcc will not complain if rnd_ma
 
 #if 1
 
-#define MAX_T  64  // maximum number of programming tasks
-#define MAX_P  10  // maximum number of programmers
+#define MAX_T  100000  // maximum number of programming tasks (the sum of the profits of a solution must fit in an int)
+#define MAX_P    1000  // maximum number of programmers
+
+#define SEARCH_MAX_T  64  // maximum number of tasks of the solvers that use fixed size arrays (exhaustive searches)
+#define SEARCH_MAX_P  10  // maximum number of programmers of the solvers that use fixed size arrays
+
+#define FILE_MAX_T  100000000  // maximum number of tasks of an instance file (only the polynomial solvers handle them)
 
 typedef struct
 {
@@ -104,6 +131,36 @@ typedef struct
 }
 task_t;
 
+//
+// search statistics (compile with -DSEARCH_STATS): for each depth of the search tree, the number of nodes visited,
+// of branches cut because no programmer is idle, and of subtrees cut by the bound; the number of leaves reached and of
+// improvements of the best solution; and the wall time spent in each band of STATS_BAND_WIDTH depths
+//
+
+#define STATS_BAND_WIDTH  8
+
+typedef struct
+{
+  int T;                  // depths 0,1,...,T
+  long long *nodes;       // T + 1 entries each
+  long long *infeasible;
+  long long *bounded;
+  long long leaves;
+  long long improvements;
+  int n_bands;
+  int band;               // band of the current node
+  double last_time;       // wall time of the last change of band
+  double *band_time;      // n_bands entries
+}
+search_stats_t;
+
+typedef struct
+{
+  int profit;             // total profit of the subset of tasks
+  uint64_t mask;          // the subset (bit i is set if task i is done)
+}
+top_entry_t;
+
 typedef struct
 {
   int NMec;               // I  student number
@@ -112,8 +169,8 @@ typedef struct
   int I;                  // I  if 1, ignore profits
   int total_profit;       // S  current total profit
   double cpu_time;        // S  time it took to find the solution
-  task_t task[MAX_T];     // IS task data
-  int busy[MAX_P];        // S  for each programmer, record until when she/he is busy (-1 means idle)
+  task_t *task;           // IS task data (T entries, allocated by init_problem())
+  int *busy;              // S  for each programmer, record until when she/he is busy (-1 means idle) (P entries)
   char dir_name[16];      // I  directory name where the solution file will be created
   char file_name[64];     // I  file name where the solution data will be stored
   
@@ -121,9 +178,190 @@ typedef struct
   long long valid_tasks;
   int sum_all_tasks;
   int *valid_tasks_profits;
+
+  int solver;                   // I  index, in the solvers[] table, of the solver used by solve()
+  int incumbent_profit;         // S  profit of the greedy solution used to seed the branch-and-bound
+  int *suffix_bound;            // S  upper bound of the profit that can be obtained with the tasks i,i+1,...,T-1
+  long long visited_nodes;      // S  number of nodes of the search tree visited by the branch-and-bound
+  long long pruned_nodes;       // S  number of subtrees of the search tree cut by the branch-and-bound
+  int n_threads;                // I  number of threads used by the parallel solvers
+  int split_depth;              // I  number of levels of the search tree expanded before the work is split (0: auto)
+  double wall_time;             // S  elapsed (wall clock) time it took to find the solution
+  int inner_solver;             // I  index of the solver used for each block by the timeline decomposition
+  int n_blocks;                 // S  number of independent blocks found by the timeline decomposition
+  int dominance;                // I  if 1, the instance reduction also drops dominated tasks
+  int n_groups;                 // S  number of groups of tasks with the same dates (instance reduction)
+  int n_dropped;                // S  number of dominated tasks dropped (instance reduction)
+  int n_histogram;              // S  number of distinct profits of the valid assignments (sparse histogram)
+  int *histogram_profit;        // S  the distinct profits, in increasing order
+  long long *histogram_count;   // S  the number of valid assignments with each one of them
+  long long n_samples;          // I  number of samples drawn by the parallel sampler (-1: no limit)
+  double time_budget;           // I  wall time budget, in seconds, of the parallel sampler (0: no limit)
+  int feasible_sampling;        // I  if 1, the parallel sampler only chooses tasks that have an idle programmer
+  long long n_drawn;            // S  number of samples drawn by the parallel sampler
+  int random_start;             // I  if 1, the local search starts from a random solution instead of the gen2() one
+  long long n_moves;            // S  number of moves tried by the local search
+  long long n_accepted;         // S  number of moves accepted by the local search
+  int n_improvements;           // S  number of improvements of the best solution found by the local search
+  double *improvement_time;     // S  elapsed time of each improvement
+  int *improvement_profit;      // S  profit of each improvement
+  int batch;                    // I  if 1, solved by one of the threads of a batch sweep
+  double checkpoint_interval;   // I  seconds between two checkpoints of the checkpointed enumeration
+  int resume;                   // I  if 1, the checkpointed enumeration resumes from its checkpoint file (if any)
+  int resumed;                  // S  if 1, the checkpointed enumeration was resumed from a checkpoint
+  double deadline;              // I  time limit, in seconds, of the branch-and-bound (0: no limit)
+  double stop_time;             // S  wall time at which the branch-and-bound stops (0: never)
+  int stopped;                  // S  if 1, the branch-and-bound reached its deadline (not proven optimal)
+  int upper_bound;              // S  upper bound of the optimum (branch-and-bound)
+  void *mapping;                // I  memory map of the instance file that holds task[] (NULL: task[] was allocated)
+  size_t mapping_size;          // I  its size, in bytes
+  int top_k;                    // I  number of best subsets of tasks kept by the top-K enumeration
+  int n_top;                    // S  number of subsets kept (at most top_k), in decreasing profit order
+  top_entry_t *top;             // S  the subsets kept (top_k entries)
+#ifdef SEARCH_STATS
+  search_stats_t *stats;        // S  statistics of the search (NULL: not collected)
+#endif
 }
 problem_t;
 
+//
+// the task data, busy[] and suffix_bound[] are allocated with the size of the problem; a copy of a problem that
+// is going to be changed (by another thread, for example) needs its own arrays
+//
+
+void alloc_problem(problem_t *problem,int T,int P)
+{
+  problem->mapping = NULL;
+  problem->task = (task_t *)malloc((size_t)T * sizeof(task_t));
+  problem->busy = (int *)malloc((size_t)P * sizeof(int));
+  problem->suffix_bound = (int *)malloc((size_t)(T + 1) * sizeof(int));
+  if(problem->task == NULL || problem->busy == NULL || problem->suffix_bound == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+}
+
+void copy_problem(problem_t *copy,problem_t *problem)
+{
+  *copy = *problem;
+  alloc_problem(copy,problem->T,problem->P);
+  memcpy(copy->task,problem->task,(size_t)problem->T * sizeof(task_t));
+  memcpy(copy->busy,problem->busy,(size_t)problem->P * sizeof(int));
+  memcpy(copy->suffix_bound,problem->suffix_bound,(size_t)(problem->T + 1) * sizeof(int));
+#ifdef SEARCH_STATS
+  copy->stats = NULL; // the copies may be used by other threads
+#endif
+}
+
+void free_problem(problem_t *problem)
+{
+#ifndef _WIN32
+  if(problem->mapping != NULL)
+    (void)munmap(problem->mapping,problem->mapping_size); // task[] is inside the mapping
+  else
+#endif
+    free(problem->task);
+  problem->mapping = NULL;
+  free(problem->busy);
+  free(problem->suffix_bound);
+  problem->task = NULL;
+  problem->busy = NULL;
+  problem->suffix_bound = NULL;
+}
+
+//
+// search statistics: the recursive searches record them with the STATS_* macros, which do nothing if SEARCH_STATS is
+// not defined or if the statistics are not being collected (stats == NULL); the wall time is only read when the
+// search crosses the boundary between two bands (the last band also gets the last, incomplete, one)
+//
+
+#ifdef SEARCH_STATS
+
+static search_stats_t *alloc_stats(int T)
+{
+  search_stats_t *stats;
+
+  stats = (search_stats_t *)calloc(1,sizeof(search_stats_t));
+  if(stats == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  stats->T = T;
+  stats->n_bands = (T < STATS_BAND_WIDTH) ? 1 : T / STATS_BAND_WIDTH;
+  stats->nodes = (long long *)calloc((size_t)(3 * (T + 1)),sizeof(long long));
+  stats->band_time = (double *)calloc((size_t)stats->n_bands,sizeof(double));
+  if(stats->nodes == NULL || stats->band_time == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  stats->infeasible = stats->nodes + (T + 1);
+  stats->bounded = stats->infeasible + (T + 1);
+  stats->band = 0;
+  stats->last_time = wall_time();
+  return stats;
+}
+
+static void free_stats(search_stats_t *stats)
+{
+  if(stats != NULL)
+  {
+    free(stats->nodes);
+    free(stats->band_time);
+    free(stats);
+  }
+}
+
+static void stats_switch_band(search_stats_t *stats,int band)
+{
+  double now = wall_time();
+
+  stats->band_time[stats->band] += now - stats->last_time;
+  stats->last_time = now;
+  stats->band = band;
+}
+
+static void print_stats(search_stats_t *stats,FILE *fp)
+{
+  int d,b;
+
+  fprintf(fp,"Search statistics (depth nodes infeasible bounded):\n");
+  for(d = 0;d <= stats->T;d++)
+    fprintf(fp,"%d %lld %lld %lld\n",d,stats->nodes[d],stats->infeasible[d],stats->bounded[d]);
+  fprintf(fp,"Leaves: %lld\n",stats->leaves);
+  fprintf(fp,"Best solution improvements: %lld\n",stats->improvements);
+  fprintf(fp,"Depth bands (first_depth last_depth wall_time):\n");
+  for(b = 0;b < stats->n_bands;b++)
+    fprintf(fp,"%d %d %.6e\n",b * STATS_BAND_WIDTH,
+            (b + 1 < stats->n_bands) ? (b + 1) * STATS_BAND_WIDTH - 1 : stats->T,stats->band_time[b]);
+}
+
+# define STATS_NODE(s,depth)        do { if((s) != NULL) (s)->nodes[depth]++; } while(0)
+# define STATS_INFEASIBLE(s,depth)  do { if((s) != NULL) (s)->infeasible[depth]++; } while(0)
+# define STATS_BOUNDED(s,depth)     do { if((s) != NULL) (s)->bounded[depth]++; } while(0)
+# define STATS_LEAF(s)              do { if((s) != NULL) (s)->leaves++; } while(0)
+# define STATS_IMPROVEMENT(s)       do { if((s) != NULL) (s)->improvements++; } while(0)
+# define STATS_BOUNDARY(s,depth)    ((s) != NULL && (depth) > 0 && (depth) % STATS_BAND_WIDTH == 0 &&       \
+                                     (depth) + STATS_BAND_WIDTH <= (s)->T)
+# define STATS_DESCEND(s,depth)     do { if(STATS_BOUNDARY(s,depth))                                         \
+                                           stats_switch_band(s,(depth) / STATS_BAND_WIDTH); } while(0)
+# define STATS_ASCEND(s,depth)      do { if(STATS_BOUNDARY(s,depth))                                         \
+                                           stats_switch_band(s,(depth) / STATS_BAND_WIDTH - 1); } while(0)
+
+#else
+
+# define STATS_NODE(s,depth)        do { } while(0)
+# define STATS_INFEASIBLE(s,depth)  do { } while(0)
+# define STATS_BOUNDED(s,depth)     do { } while(0)
+# define STATS_LEAF(s)              do { } while(0)
+# define STATS_IMPROVEMENT(s)       do { } while(0)
+# define STATS_DESCEND(s,depth)     do { } while(0)
+# define STATS_ASCEND(s,depth)      do { } while(0)
+
+#endif
+
 int compare_tasks(const void *t1,const void *t2)
 {
   int d1,d2;
@@ -139,6 +377,25 @@ int compare_tasks(const void *t1,const void *t2)
   return 0;
 }
 
+static void set_file_names(problem_t *problem)
+{ // the directory and file names of the solution of the instance (NMec, T, P and I)
+#define DIR_NAME  problem->dir_name
+  if(snprintf(DIR_NAME,sizeof(DIR_NAME),"%06d",problem->NMec) >= (int)sizeof(DIR_NAME))
+  {
+    fprintf(stderr,"Directory name too large!\n");
+    exit(1);
+  }
+#undef DIR_NAME
+#define FILE_NAME  problem->file_name
+  if(snprintf(FILE_NAME,sizeof(FILE_NAME),"%06d/%02d_%02d_%d.txt",problem->NMec,problem->T,problem->P,problem->I) >=
+     (int)sizeof(FILE_NAME))
+  {
+    fprintf(stderr,"File name too large!\n");
+    exit(1);
+  }
+#undef FILE_NAME
+}
+
 void init_problem(int NMec,int T,int P,int ignore_profit,problem_t *problem)
 {
   int i,r,scale,span,total_span;
@@ -176,7 +433,7 @@ void init_problem(int NMec,int T,int P,int ignore_profit,problem_t *problem)
   // |  0  0  4  6  8 10 12 14 16 18 | 20 | 19 18 17 16 15 14 13 12 11 10  9  8  7  6  5  4  3  2  1 | smaller than 1
   // |  0  0  2  3  4  5  6  7  8  9 | 10 | 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 | 30 31 ... span
   //
-  weight = (int *)alloca((size_t)(total_span + 1) * sizeof(int)); // allocate memory (freed automatically)
+  weight = (int *)malloc((size_t)(total_span + 1) * sizeof(int)); // allocate memory (may be too large for alloca())
   if(weight == NULL)
   {
     fprintf(stderr,"Strange! Unable to allocate memory\n");
@@ -208,11 +465,15 @@ void init_problem(int NMec,int T,int P,int ignore_profit,problem_t *problem)
   // generate the random tasks
   //
   //srandom(NMec + 314161 * T + 271829 * P);
-  srandom(NMec +314161 * T); //para ser interessante a comparação sem o numero de programadores afetar
+  srandom((int)((NMec + 314161LL * T) % 1073741824LL)); //para ser interessante a comparação sem o numero de programadores afetar
+  alloc_problem(problem,T,P);
   problem->NMec = NMec;
   problem->T = T;
   problem->P = P;
   problem->I = (ignore_profit == 0) ? 0 : 1;
+#ifdef SEARCH_STATS
+  problem->stats = NULL;
+#endif
   for(i = 0;i < T;i++)
   {
     //
@@ -224,6 +485,8 @@ void init_problem(int NMec,int T,int P,int ignore_profit,problem_t *problem)
         break;
     problem->task[i].starting_date = (int)random() % (total_span - span + 1); 
     problem->task[i].ending_date = problem->task[i].starting_date + span - 1;
+    problem->task[i].assigned_to = -1;
+    problem->task[i].best_assigned_to = -1;
     //
     // task profit
     //
@@ -247,26 +510,14 @@ void init_problem(int NMec,int T,int P,int ignore_profit,problem_t *problem)
   // sort the tasks by the starting date
   //
   qsort((void *)&problem->task[0],(size_t)problem->T,sizeof(problem->task[0]),compare_tasks);
+  free(weight);
   //
   // finish
   //
   if(problem->I != 0)
     for(i = 0;i < problem->T;i++)
       problem->task[i].profit = 1;
-#define DIR_NAME  problem->dir_name
-  if(snprintf(DIR_NAME,sizeof(DIR_NAME),"%06d",NMec) >= (int)sizeof(DIR_NAME))
-  {
-    fprintf(stderr,"Directory name too large!\n");
-    exit(1);
-  }
-#undef DIR_NAME
-#define FILE_NAME  problem->file_name
-  if(snprintf(FILE_NAME,sizeof(FILE_NAME),"%06d/%02d_%02d_%d.txt",NMec,T,P,problem->I) >= (int)sizeof(FILE_NAME))
-  {
-    fprintf(stderr,"File name too large!\n");
-    exit(1);
-  }
-#undef FILE_NAME
+  set_file_names(problem);
 }
 
 #endif
@@ -380,6 +631,7 @@ void gen2(problem_t *problem)
 
 void generate_possibilities(problem_t *problem, int tarefa_atual)//tarefa_atual inicial 0
 {
+  STATS_NODE(problem->stats,tarefa_atual);
   if(tarefa_atual < problem->T)
   {
       if(tarefa_atual == 0)
@@ -387,6 +639,7 @@ void generate_possibilities(problem_t *problem, int tarefa_atual)//tarefa_atual
         problem->best_total_profit = 0;
         problem->valid_tasks = 0;
         problem->total_profit = 0;
+        problem->sum_all_tasks = 0;
 
         for (int i = 0; i < problem->T; i++)//meter as tarefas sem serem atribuidas
         {
@@ -420,7 +673,9 @@ void generate_possibilities(problem_t *problem, int tarefa_atual)//tarefa_atual
       #endif
       
       // se nao for para contar esta tarefa fazemos logo a proxima tarefa.
+      STATS_DESCEND(problem->stats,tarefa_atual + 1);
       generate_possibilities(problem,tarefa_atual+1);
+      STATS_ASCEND(problem->stats,tarefa_atual + 1);
       //se for para contar esta tarefa fazemos todos os incrementeos necessarios e chamamos a proxima tarefa.
       int busy_copy;
       int total_profit_copy = problem->total_profit;
@@ -439,12 +694,14 @@ void generate_possibilities(problem_t *problem, int tarefa_atual)//tarefa_atual
           }
         }
       if(problem->task[tarefa_atual].assigned_to == -1)//corta se o ramo
-      {
-        problem->busy[i] = busy_copy;
+      { // no programmer is idle (i == P), so busy[] was not changed
+        STATS_INFEASIBLE(problem->stats,tarefa_atual);
         problem->total_profit=total_profit_copy;
         return;
       }
+      STATS_DESCEND(problem->stats,tarefa_atual + 1);
       generate_possibilities(problem,tarefa_atual+1);
+      STATS_ASCEND(problem->stats,tarefa_atual + 1);
       
       problem->task[tarefa_atual].assigned_to = assigned_to_copy;
       problem->busy[i] = busy_copy;
@@ -454,8 +711,10 @@ void generate_possibilities(problem_t *problem, int tarefa_atual)//tarefa_atual
     {
         problem->valid_tasks++;
         problem->valid_tasks_profits[problem->total_profit]++;
+        STATS_LEAF(problem->stats);
         if(problem->total_profit > problem->best_total_profit)
         {
+            STATS_IMPROVEMENT(problem->stats);
             problem->best_total_profit = problem->total_profit;
             for(int i = 0;i < problem->T;i++)
               problem->task[i].best_assigned_to=problem->task[i].assigned_to;
@@ -512,108 +771,4621 @@ void random_approach(problem_t *problem)
     }
   }
 }
-#if 1
 
-static void solve(problem_t *problem)
+//
+// branch-and-bound
+//
+// The search tree is the same of generate_possibilities() (first skip the task, then do it with the first idle
+// programmer), so the best solution found is exactly the same. A subtree is only explored if the profit so far plus
+// suffix_bound[tarefa_atual] can beat the best solution. The bound of the tasks i,i+1,...,T-1 is the smallest of
+// * the sum of their profits, and
+// * P times the best profit a single programmer can get with them (any valid assignment of these tasks is made of
+//   at most P sequences of tasks that do not overlap).
+// Before the search starts, a greedy solution (most profitable tasks first) gives a lower bound of the optimum.
+//
+// With -deadline seconds the search stops when the deadline is reached (the clock is read once every 65536 nodes).
+// Each subtree that is then left unexplored contributes its bound to an upper bound of the optimum, so the best
+// solution found (or the greedy one, if it is better) is reported together with the gap to that upper bound.
+//
+
+static int first_fit(problem_t *problem,const char *selected)
+{ // assign the selected tasks in starting date order; returns their profit, or -1 if they cannot all be done
+  int i,j,profit;
+
+  for(j = 0;j < problem->P;j++)
+    problem->busy[j] = -1;
+  profit = 0;
+  for(i = 0;i < problem->T;i++)
+  {
+    problem->task[i].assigned_to = -1;
+    if(selected[i] == 0)
+      continue;
+    for(j = 0;j < problem->P;j++)
+      if(problem->busy[j] < problem->task[i].starting_date)
+        break;
+    if(j == problem->P)
+      return -1;
+    problem->busy[j] = problem->task[i].ending_date;
+    problem->task[i].assigned_to = j;
+    profit += problem->task[i].profit;
+  }
+  return profit;
+}
+
+typedef struct
 {
-  FILE *fp;
-  int i;
+  int profit;
+  int index;
+}
+profit_index_t;
+
+static int compare_profit_index(const void *p1,const void *p2)
+{ // decreasing profit, then increasing index (the order of a stable sort)
+  const profit_index_t *a = (const profit_index_t *)p1;
+  const profit_index_t *b = (const profit_index_t *)p2;
+
+  if(a->profit != b->profit)
+    return (a->profit > b->profit) ? -1 : +1;
+  return (a->index < b->index) ? -1 : +1;
+}
+
+static void init_branch_and_bound(problem_t *problem,int init_search)
+{ // if init_search is 0, only the greedy solution is recomputed (in best_assigned_to)
+  int i,j,k,d,n_dates,*single,*load,*first_date,*last_date;
+  profit_index_t *order;
+  char *selected;
+
+  single = (int *)malloc((size_t)(problem->T + 1) * sizeof(int));
+  order = (profit_index_t *)malloc((size_t)problem->T * sizeof(profit_index_t));
+  selected = (char *)calloc((size_t)problem->T,sizeof(char));
+  load = (int *)calloc((size_t)problem->T,sizeof(int));
+  first_date = (int *)malloc((size_t)problem->T * 2 * sizeof(int));
+  if(single == NULL || order == NULL || selected == NULL || load == NULL || first_date == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+
   //
-  // open log file
+  // suffix bounds (the tasks are sorted by starting date, so all tasks after the first one that starts after the
+  // end of task i can be done after task i by the same programmer)
   //
-  //(void)mkdir(problem->dir_name,S_IRUSR | S_IWUSR | S_IXUSR);
-  (void)mkdir(problem->dir_name);//  o de cima nao me compila em windows
-  fp = fopen(problem->file_name,"w");
-  if(fp == NULL)
+  last_date = first_date + problem->T;
+  n_dates = 0;
+  for(i = 0;i < problem->T;i++)
   {
-    fprintf(stderr,"Unable to create file %s (maybe it already exists? If so, delete it!)\n",problem->file_name);
-    exit(1);
+    if(i > 0 && problem->task[i].starting_date != problem->task[i - 1].starting_date)
+      n_dates++;
+    first_date[i] = n_dates;
+  }
+  single[problem->T] = 0;
+  problem->suffix_bound[problem->T] = 0;
+  for(i = problem->T - 1;i >= 0;i--)
+  {
+    for(j = i + 1;j < problem->T && problem->task[j].starting_date <= problem->task[i].ending_date;j++)
+      ;
+    last_date[i] = first_date[j - 1];
+    single[i] = problem->task[i].profit + single[j];
+    if(single[i] < single[i + 1])
+      single[i] = single[i + 1];
+    problem->suffix_bound[i] = problem->suffix_bound[i + 1] + problem->task[i].profit;
+    if((long long)problem->suffix_bound[i] > (long long)problem->P * (long long)single[i])
+      problem->suffix_bound[i] = problem->P * single[i];
   }
   //
-  // solve
+  // greedy incumbent (a set of tasks can be done, by first_fit(), if and only if no date has more than P of them, so
+  // each task is checked by counting the selected tasks on each one of its dates); the most loaded date is always a
+  // starting date, so only the distinct starting dates are counted (task i is being done on the starting dates
+  // first_date[i],...,last_date[i]), whatever the span of the instance
   //
-  problem->cpu_time = cpu_time();
-  // call your (recursive?) function to solve the problem here
-  #if 0
-     int arr[problem->T];
-     problem->best_total_profit = 0;
-     problem->valid_tasks=0;
-     problem->total_profit=0;
-     for(int i=0;i<problem->P;i++)
-        problem->busy[i]=-1;
-     for(int i=0;i<problem->T;i++)
-        problem->task[i].assigned_to=-1;
-     dumb_approach(problem,arr,1);
-  #endif
-  
-  #if 0
-    generate_possibilities(problem,0);
-  #endif
-  
-  #if 0
-  //apenas para ver o numero maximo de tarefas
-    gen2(problem);
-  #endif
-  
-  #if 1
-    random_approach(problem);
-  #endif
-  
-  problem->cpu_time = cpu_time() - problem->cpu_time;
+  for(i = 0;i < problem->T;i++)
+  {
+    order[i].profit = problem->task[i].profit;
+    order[i].index = i;
+  }
+  qsort((void *)order,(size_t)problem->T,sizeof(order[0]),compare_profit_index);
+  for(k = 0;k < problem->T;k++)
+  {
+    i = order[k].index;
+    for(d = first_date[i];d <= last_date[i] && load[d] < problem->P;d++)
+      ;
+    if(d <= last_date[i])
+      continue;
+    selected[i] = 1;
+    for(d = first_date[i];d <= last_date[i];d++)
+      load[d]++;
+  }
+  problem->incumbent_profit = first_fit(problem,selected);
+  for(i = 0;i < problem->T;i++)
+    problem->task[i].best_assigned_to = problem->task[i].assigned_to;
+  free(single);
+  free(order);
+  free(selected);
+  free(load);
+  free(first_date);
+  if(init_search == 0)
+    return;
   //
-  // save solution data
+  // initial state of the search
   //
-  fprintf(fp,"NMec = %d\n",problem->NMec);
-  fprintf(fp,"T = %d\n",problem->T);
-  fprintf(fp,"P = %d\n",problem->P);
-  fprintf(fp,"Profits%s ignored\n",(problem->I == 0) ? " not" : "");
-  fprintf(fp,"Valid tasks: %I64d\n",problem->valid_tasks);//isto esta certo mas se tiveres outro melhor que lld...
-  fprintf(fp,"Solution time = %.3e\n",problem->cpu_time);
-  fprintf(fp,"Task data\n");
-#define TASK  problem->task[i]
+  problem->best_total_profit = 0; // only solutions found by the search are recorded here
+  problem->total_profit = 0;
+  problem->valid_tasks = -1;      // not counted
+  problem->visited_nodes = 0;
+  problem->pruned_nodes = 0;
+  problem->stop_time = (problem->deadline > 0.0) ? wall_time() + problem->deadline : 0.0;
+  problem->stopped = 0;
+  problem->upper_bound = 0;
   for(i = 0;i < problem->T;i++)
-    fprintf(fp,"  %3d %3d %5d %d\n",TASK.starting_date,TASK.ending_date,TASK.profit,TASK.best_assigned_to);
-#undef TASK
+    problem->task[i].assigned_to = -1;
+  for(j = 0;j < problem->P;j++)
+    problem->busy[j] = -1;
+}
 
-  fprintf(fp,"Best profit: %d\n",problem->best_total_profit);
-  
-  #if 0
-  fprintf(fp,"All profits:\n");
-  for(int i=0;i<problem->sum_all_tasks;i++)
-    if(problem->valid_tasks_profits[i] != 0)
-        fprintf(fp,"%d %d\n",i,problem->valid_tasks_profits[i]);
-  #endif
-  
-  fprintf(fp,"End\n");
+void branch_and_bound(problem_t *problem,int tarefa_atual)
+{
+  int i,busy_copy,bound;
+
+  if(problem->stopped == 0 && problem->stop_time > 0.0 && (problem->visited_nodes & 65535) == 0 &&
+     wall_time() >= problem->stop_time)
+    problem->stopped = 1;
+  if(problem->stopped != 0)
+  { // deadline reached: this subtree is not explored
+    bound = problem->total_profit + problem->suffix_bound[tarefa_atual];
+    if(bound > problem->upper_bound)
+      problem->upper_bound = bound;
+    return;
+  }
+  problem->visited_nodes++;
+  STATS_NODE(problem->stats,tarefa_atual);
+  if(tarefa_atual == problem->T)
+  {
+    STATS_LEAF(problem->stats);
+    if(problem->total_profit > problem->best_total_profit)
+    {
+      STATS_IMPROVEMENT(problem->stats);
+      problem->best_total_profit = problem->total_profit;
+      for(i = 0;i < problem->T;i++)
+        problem->task[i].best_assigned_to = problem->task[i].assigned_to;
+    }
+    return;
+  }
   //
-  // terminate
+  // cut the subtree if it cannot improve the best solution found so far, or if it cannot reach the greedy one (in
+  // this last case a strict comparison is needed so that the first optimal solution is the one recorded)
   //
-  if(fflush(fp) != 0 || ferror(fp) != 0 || fclose(fp) != 0)
+  bound = problem->total_profit + problem->suffix_bound[tarefa_atual];
+  if(bound <= problem->best_total_profit || bound < problem->incumbent_profit)
   {
-    fprintf(stderr,"Error while writing data to file %s\n",problem->file_name);
-    exit(1);
+    problem->pruned_nodes++;
+    STATS_BOUNDED(problem->stats,tarefa_atual);
+    return;
+  }
+  // skip the task
+  STATS_DESCEND(problem->stats,tarefa_atual + 1);
+  branch_and_bound(problem,tarefa_atual + 1);
+  STATS_ASCEND(problem->stats,tarefa_atual + 1);
+  // do the task (if some programmer is idle)
+  for(i = 0;i < problem->P;i++)
+    if(problem->busy[i] < problem->task[tarefa_atual].starting_date)
+      break;
+  if(i == problem->P)
+  {
+    STATS_INFEASIBLE(problem->stats,tarefa_atual);
+    return;
   }
+  busy_copy = problem->busy[i];
+  problem->busy[i] = problem->task[tarefa_atual].ending_date;
+  problem->task[tarefa_atual].assigned_to = i;
+  problem->total_profit += problem->task[tarefa_atual].profit;
+  STATS_DESCEND(problem->stats,tarefa_atual + 1);
+  branch_and_bound(problem,tarefa_atual + 1);
+  STATS_ASCEND(problem->stats,tarefa_atual + 1);
+  problem->total_profit -= problem->task[tarefa_atual].profit;
+  problem->task[tarefa_atual].assigned_to = -1;
+  problem->busy[i] = busy_copy;
 }
 
-#endif
+//
+// top-K enumeration
+//
+// The search tree of generate_possibilities(), but the K (-top) best distinct subsets of tasks are kept instead of
+// only the best one (each subset is reached by a single leaf, so the leaves are all distinct). They are kept in a
+// min-heap of (profit, subset) pairs, the subset being a 64-bit mask; once the heap is full its smallest profit is
+// the one to beat, so subtrees are cut with the bounds of the branch-and-bound. Nothing is copied when a subset is
+// recorded: the assignments are rebuilt with first_fit() only when they are needed. With K = 1 the subset found is
+// the same one found by generate_possibilities().
+//
 
+#define DEFAULT_TOP_K  10
 
+static void top_k_record(problem_t *problem,uint64_t mask)
+{ // the heap is not full or its root (the smallest profit) is beaten by total_profit
+  int i,j,profit;
+
+  profit = problem->total_profit;
+  if(problem->n_top < problem->top_k)
+  { // sift up from a new leaf
+    for(i = problem->n_top++;i > 0 && problem->top[(i - 1) / 2].profit > profit;i = (i - 1) / 2)
+      problem->top[i] = problem->top[(i - 1) / 2];
+  }
+  else
+  { // replace the root and sift down
+    for(i = 0;(j = 2 * i + 1) < problem->n_top;i = j)
+    {
+      if(j + 1 < problem->n_top && problem->top[j + 1].profit < problem->top[j].profit)
+        j++;
+      if(problem->top[j].profit >= profit)
+        break;
+      problem->top[i] = problem->top[j];
+    }
+  }
+  problem->top[i].profit = profit;
+  problem->top[i].mask = mask;
+}
+
+static void top_k_search(problem_t *problem,int tarefa_atual,uint64_t mask)
+{
+  int i,busy_copy;
+
+  STATS_NODE(problem->stats,tarefa_atual);
+  if(tarefa_atual == problem->T)
+  {
+    STATS_LEAF(problem->stats);
+    if(problem->n_top < problem->top_k || problem->total_profit > problem->top[0].profit)
+    {
+      STATS_IMPROVEMENT(problem->stats);
+      top_k_record(problem,mask);
+    }
+    return;
+  }
+  if(problem->n_top == problem->top_k &&
+     problem->total_profit + problem->suffix_bound[tarefa_atual] <= problem->top[0].profit)
+  {
+    STATS_BOUNDED(problem->stats,tarefa_atual);
+    return;
+  }
+  // skip the task
+  STATS_DESCEND(problem->stats,tarefa_atual + 1);
+  top_k_search(problem,tarefa_atual + 1,mask);
+  STATS_ASCEND(problem->stats,tarefa_atual + 1);
+  // do the task (if some programmer is idle)
+  for(i = 0;i < problem->P;i++)
+    if(problem->busy[i] < problem->task[tarefa_atual].starting_date)
+      break;
+  if(i == problem->P)
+  {
+    STATS_INFEASIBLE(problem->stats,tarefa_atual);
+    return;
+  }
+  busy_copy = problem->busy[i];
+  problem->busy[i] = problem->task[tarefa_atual].ending_date;
+  problem->total_profit += problem->task[tarefa_atual].profit;
+  STATS_DESCEND(problem->stats,tarefa_atual + 1);
+  top_k_search(problem,tarefa_atual + 1,mask | (uint64_t)1 << tarefa_atual);
+  STATS_ASCEND(problem->stats,tarefa_atual + 1);
+  problem->total_profit -= problem->task[tarefa_atual].profit;
+  problem->busy[i] = busy_copy;
+}
+
+static int compare_top_entries(const void *e1,const void *e2)
+{ // decreasing profit, then increasing subset
+  const top_entry_t *a = (const top_entry_t *)e1;
+  const top_entry_t *b = (const top_entry_t *)e2;
+
+  if(a->profit != b->profit)
+    return (a->profit > b->profit) ? -1 : +1;
+  return (a->mask < b->mask) ? -1 : (a->mask > b->mask) ? +1 : 0;
+}
+
+static void top_k_assignment(problem_t *problem,int k)
+{ // the assignment of the k-th best subset of tasks, in assigned_to
+  char selected[SEARCH_MAX_T];
+  int i;
+
+  for(i = 0;i < problem->T;i++)
+    selected[i] = (char)((problem->top[k].mask >> i) & 1);
+  (void)first_fit(problem,selected);
+}
+
+void top_k_enumeration(problem_t *problem)
+{
+  int i,j;
+
+  problem->top = (top_entry_t *)malloc((size_t)problem->top_k * sizeof(top_entry_t));
+  if(problem->top == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  init_branch_and_bound(problem,0); // only the suffix bounds are used
+  problem->n_top = 0;
+  problem->total_profit = 0;
+  problem->valid_tasks = -1;        // not counted
+  for(j = 0;j < problem->P;j++)
+    problem->busy[j] = -1;
+  top_k_search(problem,0,0);
+  qsort((void *)problem->top,(size_t)problem->n_top,sizeof(problem->top[0]),compare_top_entries);
+  problem->best_total_profit = problem->top[0].profit;
+  top_k_assignment(problem,0);
+  for(i = 0;i < problem->T;i++)
+    problem->task[i].best_assigned_to = problem->task[i].assigned_to;
+}
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
-// main program
+// min-cost flow
+//
+// Weighted interval scheduling with P programmers is a min-cost flow problem. The nodes of the network are the
+// distinct dates on which a task starts or on which a programmer becomes idle (the day after a task ends), in
+// increasing order. Consecutive nodes are joined by an arc with capacity P and cost 0 (idle programmers), and each
+// task adds an arc from its starting date to the day after its ending date with capacity 1 and cost -profit. Sending
+// (at most) P units of flow from the first node to the last one with minimum cost selects the tasks with the largest
+// total profit. The costs are negative, but all arcs go forward in time, so the initial node potentials are computed
+// in date order; after that each augmenting path is found with Dijkstra's algorithm using reduced costs.
 //
 
-int main(int argc,char **argv)
+typedef struct
 {
-  problem_t problem;
-  int NMec,T,P,I;
+  int to;                 // destination node
+  int next;               // next arc leaving the same node (-1 terminates the list)
+  int capacity;           // residual capacity
+  long long cost;         // cost per unit of flow
+}
+arc_t;
 
-  NMec = (argc < 2) ? 2020 : atoi(argv[1]);
-  T = (argc < 3) ? 5 : atoi(argv[2]);
-  P = (argc < 4) ? 2 : atoi(argv[3]);
-  I = (argc < 5) ? 0 : atoi(argv[4]);
+static int compare_ints(const void *i1,const void *i2)
+{
+  int d1 = *(const int *)i1;
+  int d2 = *(const int *)i2;
+
+  return (d1 < d2) ? -1 : (d1 > d2) ? +1 : 0;
+}
+
+static int date_node(const int *dates,int n_dates,int date)
+{ // binary search (the date is known to be there)
+  int lo = 0,hi = n_dates - 1,mid;
+
+  while(lo < hi)
+  {
+    mid = (lo + hi) / 2;
+    if(dates[mid] < date)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+void min_cost_flow(problem_t *problem)
+{
+  int T = problem->T,i,k,n_nodes,n_arcs,flow,push,u,v,heap_size,*dates,*first,*parent_arc,*heap_node;
+  long long *potential,*dist,*heap_dist,d;
+  arc_t *arc;
+  char *selected;
+
+  //
+  // allocate memory (enough for the worst case)
+  //
+  dates = (int *)malloc((size_t)(2 * T) * sizeof(int));
+  first = (int *)malloc((size_t)(2 * T) * sizeof(int));
+  parent_arc = (int *)malloc((size_t)(2 * T) * sizeof(int));
+  potential = (long long *)malloc((size_t)(2 * T) * sizeof(long long));
+  dist = (long long *)malloc((size_t)(2 * T) * sizeof(long long));
+  arc = (arc_t *)malloc((size_t)(2 * (3 * T)) * sizeof(arc_t));
+  heap_node = (int *)malloc((size_t)(2 * (3 * T) + 1) * sizeof(int));
+  heap_dist = (long long *)malloc((size_t)(2 * (3 * T) + 1) * sizeof(long long));
+  selected = (char *)calloc((size_t)T,sizeof(char));
+  if(dates == NULL || first == NULL || parent_arc == NULL || potential == NULL || dist == NULL || arc == NULL ||
+     heap_node == NULL || heap_dist == NULL || selected == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  //
+  // build the network
+  //
+  for(i = 0;i < T;i++)
+  {
+    dates[2 * i] = problem->task[i].starting_date;
+    dates[2 * i + 1] = problem->task[i].ending_date + 1;
+  }
+  qsort((void *)dates,(size_t)(2 * T),sizeof(int),compare_ints);
+  for(i = n_nodes = 1;i < 2 * T;i++)
+    if(dates[i] != dates[n_nodes - 1])
+      dates[n_nodes++] = dates[i];
+  for(u = 0;u < n_nodes;u++)
+    first[u] = -1;
+  n_arcs = 0;
+#define ADD_ARC(from,dest,cap,c)                                                                            \
+  do                                                                                                        \
+  {                                                                                                         \
+    arc[n_arcs].to = (dest); arc[n_arcs].capacity = (cap); arc[n_arcs].cost = (c);                          \
+    arc[n_arcs].next = first[from]; first[from] = n_arcs++;                                                 \
+    arc[n_arcs].to = (from); arc[n_arcs].capacity = 0; arc[n_arcs].cost = -(c);                             \
+    arc[n_arcs].next = first[dest]; first[dest] = n_arcs++;                                                 \
+  }                                                                                                         \
+  while(0)
+  for(u = 0;u + 1 < n_nodes;u++)
+    ADD_ARC(u,u + 1,problem->P,0LL);
+  for(i = 0;i < T;i++) // the arc of task i is arc 2 * (n_nodes - 1) + 2 * i
+    ADD_ARC(date_node(dates,n_nodes,problem->task[i].starting_date),
+            date_node(dates,n_nodes,problem->task[i].ending_date + 1),1,-(long long)problem->task[i].profit);
+#undef ADD_ARC
+  //
+  // initial potentials (shortest paths in an acyclic network, nodes in topological order)
+  //
+  potential[0] = 0;
+  for(u = 1;u < n_nodes;u++)
+    potential[u] = LLONG_MAX;
+  for(u = 0;u < n_nodes;u++)
+    for(k = first[u];k >= 0;k = arc[k].next)
+      if(arc[k].capacity > 0 && potential[u] + arc[k].cost < potential[arc[k].to])
+        potential[arc[k].to] = potential[u] + arc[k].cost;
+  //
+  // successive shortest paths
+  //
+  for(flow = 0;flow < problem->P;flow += push)
+  {
+    for(u = 0;u < n_nodes;u++)
+      dist[u] = LLONG_MAX;
+    dist[0] = 0;
+    heap_size = 0;
+#define HEAP_PUSH(node,key)                                                                                 \
+    do                                                                                                      \
+    {                                                                                                       \
+      for(i = ++heap_size;i > 1 && heap_dist[i / 2] > (key);i /= 2)                                         \
+      {                                                                                                     \
+        heap_node[i] = heap_node[i / 2];                                                                    \
+        heap_dist[i] = heap_dist[i / 2];                                                                    \
+      }                                                                                                     \
+      heap_node[i] = (node);                                                                                \
+      heap_dist[i] = (key);                                                                                 \
+    }                                                                                                       \
+    while(0)
+    HEAP_PUSH(0,0LL);
+    while(heap_size > 0)
+    {
+      //
+      // pop the smallest (lazy deletion: skip stale entries)
+      //
+      u = heap_node[1];
+      d = heap_dist[1];
+      v = heap_node[heap_size];
+      for(i = 1;2 * i < heap_size;i = k)
+      {
+        k = (2 * i + 1 < heap_size && heap_dist[2 * i + 1] < heap_dist[2 * i]) ? 2 * i + 1 : 2 * i;
+        if(heap_dist[k] >= heap_dist[heap_size])
+          break;
+        heap_node[i] = heap_node[k];
+        heap_dist[i] = heap_dist[k];
+      }
+      heap_node[i] = v;
+      heap_dist[i] = heap_dist[heap_size--];
+      if(d > dist[u])
+        continue;
+      for(k = first[u];k >= 0;k = arc[k].next)
+        if(arc[k].capacity > 0)
+        {
+          v = arc[k].to;
+          if(dist[u] + arc[k].cost + potential[u] - potential[v] < dist[v])
+          {
+            dist[v] = dist[u] + arc[k].cost + potential[u] - potential[v];
+            parent_arc[v] = k;
+            HEAP_PUSH(v,dist[v]);
+          }
+        }
+    }
+#undef HEAP_PUSH
+    for(u = 0;u < n_nodes;u++)
+      if(dist[u] < LLONG_MAX)
+        potential[u] += dist[u];
+    if(potential[n_nodes - 1] - potential[0] >= 0)
+      break; // no more profitable paths
+    push = problem->P - flow;
+    for(v = n_nodes - 1;v != 0;v = arc[parent_arc[v] ^ 1].to)
+      if(arc[parent_arc[v]].capacity < push)
+        push = arc[parent_arc[v]].capacity;
+    for(v = n_nodes - 1;v != 0;v = arc[parent_arc[v] ^ 1].to)
+    {
+      arc[parent_arc[v]].capacity -= push;
+      arc[parent_arc[v] ^ 1].capacity += push;
+    }
+  }
+  //
+  // the selected tasks are the ones whose arcs are saturated; assign them to the programmers
+  //
+  for(i = 0;i < T;i++)
+    selected[i] = (arc[2 * (n_nodes - 1) + 2 * i].capacity == 0) ? 1 : 0;
+  problem->best_total_profit = first_fit(problem,selected);
+  for(i = 0;i < T;i++)
+    problem->task[i].best_assigned_to = problem->task[i].assigned_to;
+  problem->valid_tasks = -1; // not counted
+  free(dates);
+  free(first);
+  free(parent_arc);
+  free(potential);
+  free(dist);
+  free(arc);
+  free(heap_node);
+  free(heap_dist);
+  free(selected);
+}
+
+//
+// weighted interval scheduling (dynamic programming, only for P = 1)
+//
+// With the tasks sorted by ending date, let best[k] be the largest profit that can be obtained with the first k
+// tasks, and let p[k] be the number of tasks that end before task k-1 starts (binary search). Then
+//   best[k] = max(best[k-1], profit of task k-1 + best[p[k]])
+// The tasks that were done are found by going backwards from k = T.
+//
+
+void weighted_interval_dp(problem_t *problem)
+{
+  int T = problem->T,i,k,lo,hi,mid,*best,*p;
+  task_t *sorted;
+
+  if(problem->P != 1)
+  { // this method only works for one programmer
+    min_cost_flow(problem);
+    return;
+  }
+  sorted = (task_t *)malloc((size_t)T * sizeof(task_t));
+  best = (int *)malloc((size_t)(T + 1) * sizeof(int));
+  p = (int *)malloc((size_t)(T + 1) * sizeof(int));
+  if(sorted == NULL || best == NULL || p == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(i = 0;i < T;i++)
+  {
+    sorted[i] = problem->task[i];
+    sorted[i].assigned_to = i; // the copy remembers the position of the task in the problem->task[] array
+    problem->task[i].best_assigned_to = -1;
+  }
+  qsort((void *)sorted,(size_t)T,sizeof(sorted[0]),compare_tasks_2);
+  best[0] = 0;
+  for(k = 1;k <= T;k++)
+  {
+    lo = 0;                 // p[k] is the number of tasks with ending_date < sorted[k-1].starting_date
+    hi = k - 1;
+    while(lo < hi)
+    {
+      mid = (lo + hi) / 2;
+      if(sorted[mid].ending_date < sorted[k - 1].starting_date)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    p[k] = lo;
+    best[k] = sorted[k - 1].profit + best[p[k]];
+    if(best[k] < best[k - 1])
+      best[k] = best[k - 1];
+  }
+  for(k = T;k > 0;)
+    if(best[k] == best[k - 1])
+      k--;
+    else
+    {
+      problem->task[sorted[k - 1].assigned_to].best_assigned_to = 0;
+      k = p[k];
+    }
+  problem->best_total_profit = best[T];
+  problem->valid_tasks = -1; // not counted
+  free(sorted);
+  free(best);
+  free(p);
+}
+
+//
+// maximum number of tasks (exact for any P when the profits are ignored)
+//
+// The tasks are processed in compare_tasks_2() order (by ending date); each one is done, if some programmer is idle
+// at its starting date, by the idle programmer that became idle last (the one with the largest busy date smaller than
+// the starting date). This choice keeps the programmers that became idle earlier for tasks that start earlier, and
+// it maximizes the number of tasks that are done. The busy dates of the programmers are kept in a treap (a binary
+// search tree balanced by random priorities), so each task costs O(log P) time: the treap is split at the starting
+// date, the largest node of the first part is removed, and, since its new busy date (the ending date of the task) is
+// not smaller than any other one, it is merged back as the largest node. With profits, the number of tasks done is
+// maximized, not their total profit.
+//
+
+typedef struct
+{
+  int busy;               // key: the date until which the programmer is busy (-1 means idle)
+  unsigned int priority;  // heap order (the root has the largest priority)
+  int left;               // children (-1 means none)
+  int right;
+}
+treap_node_t;             // one node per programmer (the node number is the programmer number)
+
+static void treap_split(treap_node_t *node,int t,int date,int *less,int *rest)
+{ // less gets the nodes with busy < date, rest gets the others
+  if(t < 0)
+    *less = *rest = -1;
+  else if(node[t].busy < date)
+  {
+    treap_split(node,node[t].right,date,&node[t].right,rest);
+    *less = t;
+  }
+  else
+  {
+    treap_split(node,node[t].left,date,less,&node[t].left);
+    *rest = t;
+  }
+}
+
+static int treap_merge(treap_node_t *node,int a,int b)
+{ // all keys of a must not be larger than those of b
+  if(a < 0)
+    return b;
+  if(b < 0)
+    return a;
+  if(node[a].priority > node[b].priority)
+  {
+    node[a].right = treap_merge(node,node[a].right,b);
+    return a;
+  }
+  node[b].left = treap_merge(node,a,node[b].left);
+  return b;
+}
+
+static int treap_remove_largest(treap_node_t *node,int t,int *largest)
+{ // the largest node has no right child, so it is replaced by its left subtree; returns the new root
+  int root,parent;
+
+  root = t;
+  for(parent = -1;node[t].right >= 0;t = node[t].right)
+    parent = t;
+  *largest = t;
+  if(parent < 0)
+    return node[t].left;
+  node[parent].right = node[t].left;
+  return root;
+}
+
+void max_tasks(problem_t *problem)
+{
+  int T = problem->T,P = problem->P,i,j,root,less,rest;
+  task_t *sorted;
+  treap_node_t *node;
+  unsigned int h;
+
+  sorted = (task_t *)malloc((size_t)T * sizeof(task_t));
+  node = (treap_node_t *)malloc((size_t)P * sizeof(treap_node_t));
+  if(sorted == NULL || node == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(i = 0;i < T;i++)
+  {
+    sorted[i] = problem->task[i];
+    sorted[i].assigned_to = i; // the copy remembers the position of the task in the problem->task[] array
+    problem->task[i].best_assigned_to = -1;
+  }
+  qsort((void *)sorted,(size_t)T,sizeof(sorted[0]),compare_tasks_2);
+  root = -1;
+  for(j = 0;j < P;j++)
+  {
+    h = (unsigned int)j * 0x9E3779B9u + 0x7F4A7C15u; // deterministic pseudo-random priorities
+    h = (h ^ (h >> 16)) * 0x85EBCA6Bu;
+    h = (h ^ (h >> 13)) * 0xC2B2AE35u;
+    node[j].busy = -1;
+    node[j].priority = h ^ (h >> 16);
+    node[j].left = node[j].right = -1;
+    root = treap_merge(node,root,j);
+  }
+  problem->best_total_profit = 0;
+  for(i = 0;i < T;i++)
+  {
+    treap_split(node,root,sorted[i].starting_date,&less,&rest);
+    if(less < 0)
+    { // no programmer is idle
+      root = rest;
+      continue;
+    }
+    less = treap_remove_largest(node,less,&j);
+    node[j].busy = sorted[i].ending_date;
+    node[j].left = node[j].right = -1;
+    root = treap_merge(node,treap_merge(node,less,rest),j);
+    problem->task[sorted[i].assigned_to].best_assigned_to = j;
+    problem->best_total_profit += sorted[i].profit;
+  }
+  problem->valid_tasks = -1; // not counted
+  free(sorted);
+  free(node);
+}
+
+//
+// parallel exhaustive enumeration (work stealing)
+//
+// The first split_depth levels of the search tree of generate_possibilities() are expanded here, in the same order
+// (first skip the task, then do it), and each valid prefix becomes a job. The jobs are distributed among the
+// deques of n_threads workers; each worker takes jobs from the front of its own deque and, when it is empty, steals
+// jobs from the back of the deques of the other workers. A worker has its own copy of the problem (busy[], the
+// current assignment, valid_tasks, the histogram and the best solution) and runs generate_possibilities() on it
+// starting at level split_depth. When merging the results, ties in the best profit are broken in favor of the job
+// with the smallest index, so the best solution is the same one found by generate_possibilities().
+//
+
+#define MAX_SPLIT_DEPTH  20  // at most 2^20 jobs
+
+typedef struct
+{
+  int total_profit;                       // profit of the tasks of the prefix
+  int busy[SEARCH_MAX_P];                 // state of the programmers after the prefix
+  signed char assigned_to[SEARCH_MAX_T];  // assignment of the tasks of the prefix
+}
+job_t;
+
+typedef struct
+{
+  struct pool_s *pool;                 // the pool this worker belongs to
+  int id;                              // index of this worker in the pool
+  pthread_t thread;
+  pthread_mutex_t lock;                // protects first and one_after_last
+  int first;                           // the deque holds the jobs first,...,one_after_last-1
+  int one_after_last;
+  problem_t copy;                      // private copy of the problem
+  int best_total_profit;               // best profit found by this worker
+  int best_job;                        // job where it was found
+  int best_assigned_to[SEARCH_MAX_T];  // and its assignment
+}
+worker_t;
+
+typedef struct pool_s
+{
+  problem_t *problem;
+  int n_jobs;
+  job_t *job;
+  int n_workers;
+  worker_t *worker;
+}
+pool_t;
+
+static void make_jobs(problem_t *problem,int tarefa_atual,int depth,pool_t *pool)
+{
+  int i,busy_copy;
+  job_t *job;
+
+  if(tarefa_atual == depth)
+  {
+    job = &pool->job[pool->n_jobs++];
+    job->total_profit = problem->total_profit;
+    for(i = 0;i < problem->P;i++)
+      job->busy[i] = problem->busy[i];
+    for(i = 0;i < depth;i++)
+      job->assigned_to[i] = (signed char)problem->task[i].assigned_to;
+    return;
+  }
+  make_jobs(problem,tarefa_atual + 1,depth,pool);
+  for(i = 0;i < problem->P;i++)
+    if(problem->busy[i] < problem->task[tarefa_atual].starting_date)
+      break;
+  if(i == problem->P)
+    return;
+  busy_copy = problem->busy[i];
+  problem->busy[i] = problem->task[tarefa_atual].ending_date;
+  problem->task[tarefa_atual].assigned_to = i;
+  problem->total_profit += problem->task[tarefa_atual].profit;
+  make_jobs(problem,tarefa_atual + 1,depth,pool);
+  problem->total_profit -= problem->task[tarefa_atual].profit;
+  problem->task[tarefa_atual].assigned_to = -1;
+  problem->busy[i] = busy_copy;
+}
+
+static int get_job(pool_t *pool,int w)
+{ // returns the index of the next job of worker w, or -1 if there is no more work to do
+  int j,v,job;
+
+  for(j = 0;j < pool->n_workers;j++)
+  {
+    v = (w + j) % pool->n_workers;
+    pthread_mutex_lock(&pool->worker[v].lock);
+    job = -1;
+    if(pool->worker[v].first < pool->worker[v].one_after_last)
+      job = (v == w) ? pool->worker[v].first++ : --pool->worker[v].one_after_last;
+    pthread_mutex_unlock(&pool->worker[v].lock);
+    if(job >= 0)
+      return job;
+  }
+  return -1;
+}
+
+static void *worker_thread(void *arg)
+{
+  worker_t *worker = (worker_t *)arg;
+  problem_t *copy = &worker->copy;
+  int i,j;
+  job_t *job;
+
+  while((j = get_job(worker->pool,worker->id)) >= 0)
+  {
+    job = &worker->pool->job[j];
+    copy->total_profit = job->total_profit;
+    copy->best_total_profit = 0;
+    for(i = 0;i < copy->P;i++)
+      copy->busy[i] = job->busy[i];
+    for(i = 0;i < copy->T;i++)
+      copy->task[i].assigned_to = -1;
+    for(i = 0;i < copy->split_depth;i++)
+      copy->task[i].assigned_to = job->assigned_to[i];
+    generate_possibilities(copy,copy->split_depth);
+    if(copy->best_total_profit > worker->best_total_profit ||
+       (copy->best_total_profit == worker->best_total_profit && copy->best_total_profit > 0 && j < worker->best_job))
+    {
+      worker->best_total_profit = copy->best_total_profit;
+      worker->best_job = j;
+      for(i = 0;i < copy->T;i++)
+        worker->best_assigned_to[i] = copy->task[i].best_assigned_to;
+    }
+  }
+  return NULL;
+}
+
+void parallel_enumeration(problem_t *problem)
+{
+  int i,w,depth,best;
+  pool_t pool;
+
+  if(problem->I == 1 && problem->P == 1)
+  { // nothing to parallelize (generate_possibilities() uses a greedy algorithm)
+    generate_possibilities(problem,0);
+    return;
+  }
+  depth = problem->split_depth; // 1 <= depth <= min(T,MAX_SPLIT_DEPTH) (level 0 is special in generate_possibilities())
+  if(depth <= 0)
+    for(depth = 8;(1 << (depth - 8)) < problem->n_threads;depth++) // about 256 jobs per worker
+      ;
+  if(depth > problem->T)
+    depth = problem->T;
+  if(depth > MAX_SPLIT_DEPTH)
+    depth = MAX_SPLIT_DEPTH;
+  if(depth < 1)
+    depth = 1;
+  //
+  // the histogram of the profits has room for all possible total profits
+  //
+  problem->sum_all_tasks = 0;
+  for(i = 0;i < problem->T;i++)
+    problem->sum_all_tasks += problem->task[i].profit;
+  problem->valid_tasks_profits = (int *)calloc((size_t)(problem->sum_all_tasks + 1),sizeof(int));
+  //
+  // the jobs, in the order generate_possibilities() would visit them
+  //
+  pool.problem = problem;
+  pool.n_jobs = 0;
+  pool.job = (job_t *)malloc(((size_t)1 << depth) * sizeof(job_t));
+  pool.n_workers = problem->n_threads;
+  pool.worker = (worker_t *)malloc((size_t)pool.n_workers * sizeof(worker_t));
+  if(problem->valid_tasks_profits == NULL || pool.job == NULL || pool.worker == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  problem->total_profit = 0;
+  for(i = 0;i < problem->P;i++)
+    problem->busy[i] = -1;
+  for(i = 0;i < problem->T;i++)
+    problem->task[i].assigned_to = -1;
+  make_jobs(problem,0,depth,&pool);
+  //
+  // run the workers (each one starts with a contiguous block of jobs)
+  //
+  for(w = 0;w < pool.n_workers;w++)
+  {
+    pool.worker[w].pool = &pool;
+    pool.worker[w].id = w;
+    pthread_mutex_init(&pool.worker[w].lock,NULL);
+    pool.worker[w].first = (int)((long long)pool.n_jobs * w / pool.n_workers);
+    pool.worker[w].one_after_last = (int)((long long)pool.n_jobs * (w + 1) / pool.n_workers);
+    copy_problem(&pool.worker[w].copy,problem);
+    pool.worker[w].copy.split_depth = depth;
+    pool.worker[w].copy.valid_tasks = 0;
+    pool.worker[w].copy.valid_tasks_profits = (int *)calloc((size_t)(problem->sum_all_tasks + 1),sizeof(int));
+    if(pool.worker[w].copy.valid_tasks_profits == NULL)
+    {
+      fprintf(stderr,"Strange! Unable to allocate memory\n");
+      exit(1);
+    }
+    pool.worker[w].best_total_profit = 0;
+    pool.worker[w].best_job = pool.n_jobs;
+  }
+  for(w = 0;w < pool.n_workers;w++)
+    if(pthread_create(&pool.worker[w].thread,NULL,worker_thread,&pool.worker[w]) != 0)
+    {
+      fprintf(stderr,"Unable to create thread %d\n",w);
+      exit(1);
+    }
+  for(w = 0;w < pool.n_workers;w++)
+    pthread_join(pool.worker[w].thread,NULL);
+  //
+  // merge the results
+  //
+  problem->valid_tasks = 0;
+  best = 0;
+  for(w = 0;w < pool.n_workers;w++)
+  {
+    problem->valid_tasks += pool.worker[w].copy.valid_tasks;
+    for(i = 0;i <= problem->sum_all_tasks;i++)
+      problem->valid_tasks_profits[i] += pool.worker[w].copy.valid_tasks_profits[i];
+    if(pool.worker[w].best_total_profit > pool.worker[best].best_total_profit ||
+       (pool.worker[w].best_total_profit == pool.worker[best].best_total_profit &&
+        pool.worker[w].best_job < pool.worker[best].best_job))
+      best = w;
+  }
+  problem->best_total_profit = pool.worker[best].best_total_profit;
+  for(i = 0;i < problem->T;i++)
+    problem->task[i].best_assigned_to = pool.worker[best].best_assigned_to[i];
+  for(w = 0;w < pool.n_workers;w++)
+  {
+    pthread_mutex_destroy(&pool.worker[w].lock);
+    free(pool.worker[w].copy.valid_tasks_profits);
+    free_problem(&pool.worker[w].copy);
+  }
+  free(pool.job);
+  free(pool.worker);
+}
+
+//
+// bitmask enumeration (Gray code order)
+//
+// Each subset of tasks is a 64-bit mask. Consecutive subsets in Gray code order differ in a single bit (the number
+// of trailing zeros of the step number), so the profit is updated with one addition or subtraction. For each distinct
+// starting date d, active[d] is the mask of the tasks that are being done on that date; a subset S can be done by P
+// programmers if and only if popcount(S & active[d]) <= P for all d (the largest number of simultaneous tasks is
+// attained on a starting date). Flipping a bit only changes the counts of the dates of that task, so these counts
+// are kept up to date, and n_over is the number of dates with more than P tasks.
+// Bit b is flipped once every 2^(b+1) steps, so the tasks that span fewer dates get the lower bits. After flipping
+// bit b, the next 2^b-1 subsets only differ in the bits below b; when the bits b,b+1,...,T-1 of S are already
+// infeasible (checked with popcounts), all of them are skipped.
+//
+
+static inline int popcount64(uint64_t x)
+{
+#ifdef __GNUC__
+  return __builtin_popcountll(x);
+#else
+  int n;
+
+  for(n = 0;x != 0;n++)
+    x &= x - 1;
+  return n;
+#endif
+}
+
+static inline int ctz64(uint64_t x)
+{ // x must not be zero
+#ifdef __GNUC__
+  return __builtin_ctzll(x);
+#else
+  int n;
+
+  for(n = 0;(x & 1) == 0;n++)
+    x >>= 1;
+  return n;
+#endif
+}
+
+#define MIN_SKIP_BIT  4  // only try to skip blocks of at least 2^4 subsets
+
+void bitmask_enumeration(problem_t *problem)
+{
+  int T = problem->T,P = problem->P,i,j,b,d,n_dates,n_over,profit;
+  int task_of_bit[SEARCH_MAX_T],bit_profit[SEARCH_MAX_T],first_date[SEARCH_MAX_T],one_after_last_date[SEARCH_MAX_T];
+  int bit_first_date[SEARCH_MAX_T],bit_one_after_last_date[SEARCH_MAX_T],count[SEARCH_MAX_T];
+  uint64_t active[SEARCH_MAX_T],S,best_S,k,n_subsets,high,low;
+  char selected[SEARCH_MAX_T] = { 0 };
+
+  //
+  // the dates of task i are first_date[i],...,one_after_last_date[i]-1 (the tasks are sorted by starting date)
+  //
+  n_dates = 0;
+  for(i = 0;i < T;i++)
+  {
+    if(i > 0 && problem->task[i].starting_date != problem->task[i - 1].starting_date)
+      n_dates++;
+    first_date[i] = n_dates;
+  }
+  n_dates++;
+  for(i = 0;i < T;i++)
+  {
+    for(j = i;j < T && problem->task[j].starting_date <= problem->task[i].ending_date;j++)
+      ;
+    one_after_last_date[i] = (j < T) ? first_date[j] : n_dates;
+  }
+  //
+  // the tasks that span fewer dates get the lower bits (these are the ones that are flipped more often)
+  //
+  for(i = 0;i < T;i++)
+  {
+    for(b = i;b > 0 && one_after_last_date[task_of_bit[b - 1]] - first_date[task_of_bit[b - 1]] >
+                       one_after_last_date[i] - first_date[i];b--)
+      task_of_bit[b] = task_of_bit[b - 1];
+    task_of_bit[b] = i;
+  }
+  for(d = 0;d < n_dates;d++)
+    active[d] = 0;
+  for(b = 0;b < T;b++)
+  {
+    i = task_of_bit[b];
+    bit_profit[b] = problem->task[i].profit;
+    bit_first_date[b] = first_date[i];
+    bit_one_after_last_date[b] = one_after_last_date[i];
+    for(d = first_date[i];d < one_after_last_date[i];d++)
+      active[d] |= (uint64_t)1 << b;
+  }
+  //
+  // the histogram of the profits has room for all possible total profits
+  //
+  problem->sum_all_tasks = 0;
+  for(i = 0;i < T;i++)
+    problem->sum_all_tasks += problem->task[i].profit;
+  problem->valid_tasks_profits = (int *)calloc((size_t)(problem->sum_all_tasks + 1),sizeof(int));
+  if(problem->valid_tasks_profits == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  //
+  // enumerate (the empty subset first)
+  //
+  S = best_S = 0;
+  profit = 0;
+  n_over = 0;
+  for(d = 0;d < n_dates;d++)
+    count[d] = 0;
+  problem->valid_tasks = 1;
+  problem->valid_tasks_profits[0]++;
+  problem->best_total_profit = 0;
+  n_subsets = (T == 64) ? 0 : (uint64_t)1 << T; // for T == 64 the loop ends when k wraps around to 0
+#define FLIP(bit)                                                                                           \
+  do                                                                                                        \
+  {                                                                                                         \
+    int b_ = (bit);                                                                                         \
+                                                                                                            \
+    S ^= (uint64_t)1 << b_;                                                                                 \
+    if((S >> b_) & 1)                                                                                       \
+    {                                                                                                       \
+      profit += bit_profit[b_];                                                                             \
+      for(d = bit_first_date[b_];d < bit_one_after_last_date[b_];d++)                                       \
+        n_over += (++count[d] == P + 1);                                                                    \
+    }                                                                                                       \
+    else                                                                                                    \
+    {                                                                                                       \
+      profit -= bit_profit[b_];                                                                             \
+      for(d = bit_first_date[b_];d < bit_one_after_last_date[b_];d++)                                       \
+        n_over -= (count[d]-- == P + 1);                                                                    \
+    }                                                                                                       \
+  }                                                                                                         \
+  while(0)
+  for(k = 1;k != n_subsets;k++)
+  {
+    b = ctz64(k);
+    FLIP(b);
+    if(n_over != 0 && b >= MIN_SKIP_BIT)
+    { // if the tasks of bits b,b+1,...,T-1 of S cannot be done, skip the next 2^b-1 subsets (they only change bits
+      // 0,1,...,b-1)
+      high = S & ~(((uint64_t)1 << b) - 1);
+      for(d = 0;d < n_dates && popcount64(high & active[d]) <= P;d++)
+        ;
+      if(d < n_dates)
+      {
+        k += ((uint64_t)1 << b) - 1;
+        for(low = (S ^ (k ^ (k >> 1))) & (((uint64_t)1 << b) - 1);low != 0;low &= low - 1)
+          FLIP(ctz64(low));
+        continue;
+      }
+    }
+    if(n_over == 0)
+    {
+      problem->valid_tasks++;
+      problem->valid_tasks_profits[profit]++;
+      if(profit > problem->best_total_profit)
+      {
+        problem->best_total_profit = profit;
+        best_S = S;
+      }
+    }
+  }
+#undef FLIP
+  //
+  // the assignment of the best subset
+  //
+  for(b = 0;b < T;b++)
+    selected[task_of_bit[b]] = (best_S >> b) & 1;
+  (void)first_fit(problem,selected);
+  for(i = 0;i < T;i++)
+    problem->task[i].best_assigned_to = problem->task[i].assigned_to;
+}
+
+//
+// instance reduction
+//
+// Tasks with the same starting and ending dates are merged into a group. Doing c tasks of a group with k tasks can
+// be done in C(k,c) ways, but only the distinct pairs (c, total profit of the c tasks) matter, each with the number
+// of ways of getting it (this is a big saving when the profits are ignored). The search tree has one level per
+// group, and each node carries the number of subsets it stands for, so valid_tasks and the histogram are exact.
+// Optionally (-dominance), a task b is also dropped when, on some date, at least P kept tasks a that are better than
+// b are being done; a is better than b when its dates are inside those of b and its profit is not smaller (ties
+// broken by the size of the interval, then by the task number). In an optimal solution b can always be replaced by
+// one of those P tasks, so the best profit is not changed, but the valid assignments are no longer counted.
+//
+
+#define MAX_GROUP  16  // larger groups are split
+
+typedef struct
+{
+  int k;                      // number of tasks of the group
+  int task[MAX_GROUP];        // their numbers
+  int n_choices;              // number of distinct (c, profit) pairs
+  int *c;                     // number of tasks done
+  int *profit;                // their total profit
+  long long *ways;            // number of ways of getting this pair
+  int *mask;                  // one of them (bit j set means that task[j] is done)
+}
+group_t;
+
+typedef struct
+{
+  int n_groups;
+  group_t group[SEARCH_MAX_T];
+  long long weight;           // number of subsets represented by the current node of the search tree
+}
+reduction_t;
+
+static int better_task(problem_t *problem,int a,int b)
+{ // a is better than b
+  task_t *ta = &problem->task[a],*tb = &problem->task[b];
+
+  if(a == b || ta->starting_date < tb->starting_date || ta->ending_date > tb->ending_date || ta->profit < tb->profit)
+    return 0;
+  if(ta->ending_date - ta->starting_date != tb->ending_date - tb->starting_date)
+    return 1;
+  return (ta->profit != tb->profit) ? 1 : (a < b);
+}
+
+static int task_key_less(problem_t *problem,int a,int b)
+{
+  int la = problem->task[a].ending_date - problem->task[a].starting_date;
+  int lb = problem->task[b].ending_date - problem->task[b].starting_date;
+
+  if(la != lb)
+    return la < lb;
+  if(problem->task[a].profit != problem->task[b].profit)
+    return problem->task[a].profit > problem->task[b].profit;
+  return a < b;
+}
+
+static void reduce_problem(problem_t *problem,reduction_t *r,int dominance)
+{
+  int i,j,m,n,d,order[SEARCH_MAX_T],kept[SEARCH_MAX_T],sum,cnt;
+  group_t *g;
+
+  //
+  // dominated tasks; if a is better than b then a has a shorter interval, or the same interval and a larger profit,
+  // or the same interval and profit and a smaller task number, so in this order a task can only be removed because
+  // of tasks that come before it (and that were already kept or removed)
+  //
+  for(i = 0;i < problem->T;i++)
+  {
+    for(j = i;j > 0 && task_key_less(problem,i,order[j - 1]);j--)
+      order[j] = order[j - 1];
+    order[j] = i;
+    kept[i] = 1;
+  }
+  problem->n_dropped = 0;
+  if(dominance != 0)
+    for(n = 0;n < problem->T;n++)
+    {
+      i = order[n];
+      for(j = 0;j < problem->T && kept[i] != 0;j++)
+        if(kept[j] != 0 && better_task(problem,j,i))
+        { // count the kept tasks better than i that are being done on the starting date of task j
+          d = problem->task[j].starting_date;
+          for(cnt = m = 0;m < problem->T;m++)
+            if(kept[m] != 0 && better_task(problem,m,i) &&
+               problem->task[m].starting_date <= d && d <= problem->task[m].ending_date)
+              cnt++;
+          if(cnt >= problem->P)
+          {
+            kept[i] = 0;
+            problem->n_dropped++;
+          }
+        }
+    }
+  //
+  // groups of kept tasks with the same dates (they are consecutive, because the tasks are sorted by dates)
+  //
+  r->n_groups = 0;
+  for(i = 0;i < problem->T;i++)
+  {
+    if(kept[i] == 0)
+      continue;
+    n = r->n_groups - 1; // the last group (none if n < 0)
+    if(n < 0 || r->group[n].k == MAX_GROUP ||
+       problem->task[r->group[n].task[0]].starting_date != problem->task[i].starting_date ||
+       problem->task[r->group[n].task[0]].ending_date != problem->task[i].ending_date)
+    {
+      n = r->n_groups++;
+      r->group[n].k = 0;
+    }
+    g = &r->group[n];
+    g->task[g->k++] = i;
+  }
+  for(n = 0;n < r->n_groups;n++)
+  {
+    g = &r->group[n];
+    g->c = (int *)malloc(((size_t)1 << g->k) * sizeof(int));
+    g->profit = (int *)malloc(((size_t)1 << g->k) * sizeof(int));
+    g->ways = (long long *)malloc(((size_t)1 << g->k) * sizeof(long long));
+    g->mask = (int *)malloc(((size_t)1 << g->k) * sizeof(int));
+    if(g->c == NULL || g->profit == NULL || g->ways == NULL || g->mask == NULL)
+    {
+      fprintf(stderr,"Strange! Unable to allocate memory\n");
+      exit(1);
+    }
+    g->n_choices = 0;
+    for(m = 0;m < (1 << g->k);m++)
+    {
+      for(cnt = sum = j = 0;j < g->k;j++)
+        if((m >> j) & 1)
+        {
+          cnt++;
+          sum += problem->task[g->task[j]].profit;
+        }
+      for(j = 0;j < g->n_choices && (g->c[j] != cnt || g->profit[j] != sum);j++)
+        ;
+      if(j == g->n_choices)
+      {
+        g->c[j] = cnt;
+        g->profit[j] = sum;
+        g->ways[j] = 0;
+        g->mask[j] = m;
+        g->n_choices++;
+      }
+      g->ways[j]++;
+    }
+  }
+}
+
+static void reduced_search(problem_t *problem,reduction_t *r,int n)
+{
+  int i,j,m,free_programmers[SEARCH_MAX_P],n_free,busy_copy[SEARCH_MAX_P];
+  long long weight_copy;
+  group_t *g;
+
+  if(n == r->n_groups)
+  {
+    if(problem->valid_tasks >= 0)
+    {
+      problem->valid_tasks += r->weight;
+      problem->valid_tasks_profits[problem->total_profit] += (int)r->weight;
+    }
+    if(problem->total_profit > problem->best_total_profit)
+    {
+      problem->best_total_profit = problem->total_profit;
+      for(i = 0;i < problem->T;i++)
+        problem->task[i].best_assigned_to = problem->task[i].assigned_to;
+    }
+    return;
+  }
+  g = &r->group[n];
+  for(n_free = i = 0;i < problem->P;i++)
+    if(problem->busy[i] < problem->task[g->task[0]].starting_date)
+      free_programmers[n_free++] = i;
+  weight_copy = r->weight;
+  for(i = 0;i < problem->P;i++)
+    busy_copy[i] = problem->busy[i];
+  for(j = 0;j < g->n_choices;j++)
+    if(g->c[j] <= n_free)
+    { // do the tasks of the mask with the first idle programmers
+      for(i = m = 0;i < g->k;i++)
+        if((g->mask[j] >> i) & 1)
+        {
+          problem->task[g->task[i]].assigned_to = free_programmers[m];
+          problem->busy[free_programmers[m++]] = problem->task[g->task[i]].ending_date;
+        }
+      problem->total_profit += g->profit[j];
+      r->weight = weight_copy * g->ways[j];
+      reduced_search(problem,r,n + 1);
+      problem->total_profit -= g->profit[j];
+      for(i = 0;i < g->k;i++)
+        problem->task[g->task[i]].assigned_to = -1;
+      for(i = 0;i < problem->P;i++)
+        problem->busy[i] = busy_copy[i];
+    }
+  r->weight = weight_copy;
+}
+
+void reduced_enumeration(problem_t *problem)
+{
+  reduction_t *r; // too large for the stack of some systems (and one per call, for the workers of -batch)
+  int i,n;
+
+  r = (reduction_t *)malloc(sizeof(reduction_t));
+  if(r == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  reduce_problem(problem,r,problem->dominance);
+  problem->n_groups = r->n_groups;
+  problem->sum_all_tasks = 0;
+  for(i = 0;i < problem->T;i++)
+  {
+    problem->sum_all_tasks += problem->task[i].profit;
+    problem->task[i].assigned_to = -1;
+    problem->task[i].best_assigned_to = -1;
+  }
+  problem->valid_tasks_profits = NULL;
+  if(problem->dominance == 0)
+  {
+    problem->valid_tasks_profits = (int *)calloc((size_t)(problem->sum_all_tasks + 1),sizeof(int));
+    if(problem->valid_tasks_profits == NULL)
+    {
+      fprintf(stderr,"Strange! Unable to allocate memory\n");
+      exit(1);
+    }
+  }
+  for(i = 0;i < problem->P;i++)
+    problem->busy[i] = -1;
+  problem->total_profit = 0;
+  problem->best_total_profit = 0;
+  problem->valid_tasks = (problem->dominance == 0) ? 0 : -1; // with dominance, not counted
+  r->weight = 1;
+  reduced_search(problem,r,0);
+  for(n = 0;n < r->n_groups;n++)
+  {
+    free(r->group[n].c);
+    free(r->group[n].profit);
+    free(r->group[n].ways);
+    free(r->group[n].mask);
+  }
+  free(r);
+}
+
+//
+// exact histogram of the profits (sweep line dynamic programming)
+//
+// The tasks are processed by starting date. The state of the sweep is the multiset of the selected tasks that are
+// still being done; a task is represented by its release rank, the number of distinct starting dates on which it is
+// being done or that come before it, so tasks that become free on the same starting date are equivalent. The state
+// never has more than P tasks. For each state a sparse histogram (increasing profits, number of subsets) is kept;
+// when task i is processed the tasks that no longer are being done are removed from each state (states that become
+// equal are merged) and each state gives two new ones, without task i and (if there is an idle programmer) with it,
+// its histogram shifted by the profit of task i. The cost depends on the number of simultaneous tasks, not on 2^T.
+// The best profit is the largest one of the histogram; the assignment is found with min_cost_flow().
+//
+
+typedef struct
+{
+  int n;                      // number of selected tasks still being done
+  int release[SEARCH_MAX_P];  // their release ranks (sorted)
+  int size;                   // number of entries of the histogram
+  int *profit;                // distinct profits (increasing)
+  long long *count;           // number of subsets with each profit
+}
+sweep_state_t;
+
+typedef struct
+{
+  int n_states;
+  int max_states;
+  sweep_state_t *state;
+  int hash_size;              // a power of two (at least twice max_states)
+  int *hash;                  // index of the state, or -1
+}
+sweep_map_t;
+
+static void sweep_map_init(sweep_map_t *map,int max_states)
+{
+  int i;
+
+  map->n_states = 0;
+  map->max_states = max_states;
+  for(map->hash_size = 16;map->hash_size < 2 * max_states;map->hash_size *= 2)
+    ;
+  map->state = (sweep_state_t *)malloc((size_t)map->max_states * sizeof(sweep_state_t));
+  map->hash = (int *)malloc((size_t)map->hash_size * sizeof(int));
+  if(map->state == NULL || map->hash == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(i = 0;i < map->hash_size;i++)
+    map->hash[i] = -1;
+}
+
+static void sweep_map_free(sweep_map_t *map)
+{
+  int i;
+
+  for(i = 0;i < map->n_states;i++)
+  {
+    free(map->state[i].profit);
+    free(map->state[i].count);
+  }
+  free(map->state);
+  free(map->hash);
+}
+
+static unsigned int sweep_hash(int n,const int *release)
+{
+  unsigned int h;
+  int j;
+
+  for(h = (unsigned int)n,j = 0;j < n;j++)
+    h = h * 1000003u + (unsigned int)release[j];
+  return h;
+}
+
+static void sweep_map_add(sweep_map_t *map,int n,const int *release,const sweep_state_t *from,int shift)
+{ // add the histogram of from, with all profits increased by shift, to the state (n,release[])
+  int i,j,size,*profit;
+  unsigned int h;
+  long long *count;
+  sweep_state_t *s;
+  sweep_map_t bigger;
+
+  if(map->n_states == map->max_states)
+  { // grow (rehash)
+    sweep_map_init(&bigger,2 * map->max_states);
+    for(i = 0;i < map->n_states;i++)
+    {
+      s = &map->state[i];
+      for(h = sweep_hash(s->n,s->release) & (bigger.hash_size - 1);bigger.hash[h] >= 0;
+          h = (h + 1) & (bigger.hash_size - 1))
+        ;
+      bigger.hash[h] = i;
+      bigger.state[i] = *s;
+    }
+    bigger.n_states = map->n_states;
+    free(map->state);
+    free(map->hash);
+    *map = bigger;
+  }
+  for(h = sweep_hash(n,release) & (map->hash_size - 1);map->hash[h] >= 0;h = (h + 1) & (map->hash_size - 1))
+  {
+    s = &map->state[map->hash[h]];
+    if(s->n == n && memcmp(s->release,release,(size_t)n * sizeof(int)) == 0)
+      break;
+  }
+  if(map->hash[h] < 0)
+  { // new state
+    map->hash[h] = map->n_states;
+    s = &map->state[map->n_states++];
+    s->n = n;
+    memcpy(s->release,release,(size_t)n * sizeof(int));
+    s->size = 0;
+    s->profit = NULL;
+    s->count = NULL;
+  }
+  else
+    s = &map->state[map->hash[h]];
+  //
+  // merge the two sorted histograms
+  //
+  profit = (int *)malloc((size_t)(s->size + from->size) * sizeof(int));
+  count = (long long *)malloc((size_t)(s->size + from->size) * sizeof(long long));
+  if(profit == NULL || count == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(i = j = size = 0;i < s->size || j < from->size;size++)
+    if(j == from->size || (i < s->size && s->profit[i] < from->profit[j] + shift))
+    {
+      profit[size] = s->profit[i];
+      count[size] = s->count[i++];
+    }
+    else if(i == s->size || s->profit[i] > from->profit[j] + shift)
+    {
+      profit[size] = from->profit[j] + shift;
+      count[size] = from->count[j++];
+    }
+    else
+    {
+      profit[size] = s->profit[i];
+      count[size] = s->count[i++] + from->count[j++];
+    }
+  free(s->profit);
+  free(s->count);
+  s->size = size;
+  s->profit = profit;
+  s->count = count;
+}
+
+void histogram_sweep(problem_t *problem)
+{
+  int i,j,k,m,n,rank,release_i,n_ranks,*start_rank,release[SEARCH_MAX_P + 1];
+  sweep_map_t old_map,new_map;
+  sweep_state_t empty,*s;
+  int zero = 0;
+  long long one = 1;
+
+  //
+  // rank of the starting date of each task, and the number of distinct starting dates
+  //
+  start_rank = (int *)malloc((size_t)problem->T * sizeof(int));
+  if(start_rank == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(n_ranks = i = 0;i < problem->T;i++)
+  {
+    if(i > 0 && problem->task[i].starting_date != problem->task[i - 1].starting_date)
+      n_ranks++;
+    start_rank[i] = n_ranks;
+  }
+  n_ranks++;
+  //
+  // sweep (initially, one empty state whose histogram says that the empty subset has profit 0)
+  //
+  sweep_map_init(&old_map,16);
+  empty.size = 1;
+  empty.profit = &zero;
+  empty.count = &one;
+  sweep_map_add(&old_map,0,release,&empty,0);
+  for(i = 0;i < problem->T;i++)
+  {
+    rank = start_rank[i];
+    for(j = i;j < problem->T && problem->task[j].starting_date <= problem->task[i].ending_date;j++)
+      ;
+    release_i = (j < problem->T) ? start_rank[j] : n_ranks;
+    sweep_map_init(&new_map,2 * old_map.n_states);
+    for(k = 0;k < old_map.n_states;k++)
+    {
+      s = &old_map.state[k];
+      for(n = m = 0;m < s->n;m++)
+        if(s->release[m] > rank) // still being done on this starting date
+          release[n++] = s->release[m];
+      sweep_map_add(&new_map,n,release,s,0);
+      if(n < problem->P)
+      {
+        for(m = n;m > 0 && release[m - 1] > release_i;m--)
+          release[m] = release[m - 1];
+        release[m] = release_i;
+        sweep_map_add(&new_map,n + 1,release,s,problem->task[i].profit);
+      }
+    }
+    sweep_map_free(&old_map);
+    old_map = new_map;
+  }
+  //
+  // the histogram is the sum of the histograms of all states
+  //
+  sweep_map_init(&new_map,1);
+  for(k = 0;k < old_map.n_states;k++)
+    sweep_map_add(&new_map,0,release,&old_map.state[k],0);
+  s = &new_map.state[0];
+  problem->n_histogram = s->size;
+  problem->histogram_profit = s->profit;
+  problem->histogram_count = s->count;
+  s->profit = NULL;
+  s->count = NULL;
+  sweep_map_free(&new_map);
+  sweep_map_free(&old_map);
+  free(start_rank);
+  //
+  // the best assignment (min_cost_flow() does not count the valid assignments, so that is done afterwards)
+  //
+  min_cost_flow(problem);
+  if(problem->best_total_profit != problem->histogram_profit[problem->n_histogram - 1])
+  {
+    fprintf(stderr,"histogram_sweep: best profit mismatch (%d != %d)\n",problem->best_total_profit,
+            problem->histogram_profit[problem->n_histogram - 1]);
+    exit(1);
+  }
+  problem->valid_tasks = 0;
+  for(k = 0;k < problem->n_histogram;k++)
+    problem->valid_tasks += problem->histogram_count[k];
+}
+
+//
+// parallel Monte Carlo sampler
+//
+// Replaces the rand() calls of random_approach() by one pseudo-random number stream per chunk of SAMPLER_CHUNK
+// samples (rand() has a single hidden state, so it cannot be shared by the threads). Chunk c uses the stream seeded
+// with (NMec,T,P,c), and the threads take the chunks in increasing order, so with a sample budget (-samples n, the
+// number of draws, valid or not) the results do not depend on the number of threads (for equal profits the best
+// sample of the smallest chunk is kept). With a time budget (-time seconds) the clock is read every SAMPLER_CHECK
+// samples of a chunk (fewer for large T, about SAMPLER_CHECK_WORK tasks between two readings), and the sampling stops,
+// in the middle of a chunk, once the deadline is reached; -samples -1 removes the sample budget. There are two
+// sampling modes:
+// * blind (as in random_approach()): each task is chosen with probability 1/2, and the draw is discarded as soon as
+//   a chosen task finds no idle programmer;
+// * feasible (-feasible): only the tasks that have an idle programmer can be chosen (each with probability 1/2), so
+//   no draw is wasted.
+//
+
+#define SAMPLER_CHUNK  65536
+#define SAMPLER_CHECK       4096      // maximum number of samples between two readings of the clock
+#define SAMPLER_CHECK_WORK  (1 << 22) // number of tasks visited between two readings of the clock (large T)
+
+typedef struct
+{
+  uint64_t state;
+}
+stream_t;
+
+static uint64_t splitmix64(uint64_t *x)
+{
+  uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static void stream_start(stream_t *stream,uint64_t seed,uint64_t stream_number)
+{
+  uint64_t x = seed ^ (stream_number * 0xD1B54A32D192ED03ull);
+
+  stream->state = splitmix64(&x);
+  if(stream->state == 0)
+    stream->state = 1;
+}
+
+static inline uint64_t stream_next(stream_t *stream)
+{ // xorshift64*
+  stream->state ^= stream->state >> 12;
+  stream->state ^= stream->state << 25;
+  stream->state ^= stream->state >> 27;
+  return stream->state * 0x2545F4914F6CDD1Dull;
+}
+
+typedef struct
+{
+  problem_t *problem;
+  pthread_t thread;
+  pthread_mutex_t *lock;      // protects *next_chunk
+  long long *next_chunk;
+  long long n_samples;        // number of samples (-1 means no limit)
+  double deadline;            // wall time limit (0 means no limit)
+  uint64_t seed;              // seed of the pseudo-random number streams
+  long long drawn;            // number of samples drawn
+  long long valid;            // number of valid samples
+  int best_total_profit;
+  long long best_chunk;       // chunk of the best sample
+  int *best_assigned_to;      // its assignment (T entries)
+  int *assigned_to;           // work space (T entries)
+  int *busy;                  // work space (P entries)
+}
+sampler_t;
+
+static void *sampler_thread(void *arg)
+{
+  sampler_t *sampler = (sampler_t *)arg;
+  problem_t *problem = sampler->problem;
+  int T = problem->T,P = problem->P,feasible = problem->feasible_sampling,i,j,n,n_chunk,profit,check_every,countdown;
+  int *busy = sampler->busy,*assigned_to = sampler->assigned_to;
+  long long chunk;
+  uint64_t bits;
+  stream_t stream;
+
+  check_every = (T < SAMPLER_CHECK_WORK / SAMPLER_CHECK) ? SAMPLER_CHECK : SAMPLER_CHECK_WORK / T;
+  if(check_every < 1)
+    check_every = 1;
+  for(;;)
+  {
+    pthread_mutex_lock(sampler->lock);
+    chunk = (*sampler->next_chunk)++;
+    pthread_mutex_unlock(sampler->lock);
+    n_chunk = SAMPLER_CHUNK;
+    if(sampler->n_samples >= 0 && sampler->n_samples - chunk * SAMPLER_CHUNK < (long long)n_chunk)
+      n_chunk = (int)(sampler->n_samples - chunk * SAMPLER_CHUNK);
+    if(n_chunk <= 0 || (sampler->deadline > 0.0 && wall_time() >= sampler->deadline))
+      break;
+    stream_start(&stream,sampler->seed,(uint64_t)chunk);
+    countdown = check_every;
+    for(n = 0;n < n_chunk;n++)
+    {
+      if(--countdown == 0)
+      {
+        if(sampler->deadline > 0.0 && wall_time() >= sampler->deadline)
+          break;
+        countdown = check_every;
+      }
+      sampler->drawn++;
+      for(j = 0;j < P;j++)
+        busy[j] = -1;
+      profit = 0;
+      bits = 0;
+      for(i = 0;i < T;i++)
+      {
+        if((i & 63) == 0)
+          bits = stream_next(&stream);
+        assigned_to[i] = -1;
+        for(j = 0;j < P;j++)
+          if(busy[j] < problem->task[i].starting_date)
+            break;
+        if(((bits >> (i & 63)) & 1) == 0 || (feasible != 0 && j == P))
+          continue; // not chosen
+        if(j == P)
+          break;    // chosen, but cannot be done (blind sampling only)
+        busy[j] = problem->task[i].ending_date;
+        assigned_to[i] = j;
+        profit += problem->task[i].profit;
+      }
+      if(i < T)
+        continue;
+      sampler->valid++;
+      if(profit > sampler->best_total_profit)
+      {
+        sampler->best_total_profit = profit;
+        sampler->best_chunk = chunk;
+        for(i = 0;i < T;i++)
+          sampler->best_assigned_to[i] = assigned_to[i];
+      }
+    }
+  }
+  return NULL;
+}
+
+void parallel_sampler(problem_t *problem)
+{
+  int i,w,best;
+  long long next_chunk;
+  double deadline;
+  pthread_mutex_t lock;
+  sampler_t *sampler;
+
+  sampler = (sampler_t *)malloc((size_t)problem->n_threads * sizeof(sampler_t));
+  if(sampler == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  pthread_mutex_init(&lock,NULL);
+  next_chunk = 0;
+  deadline = (problem->time_budget > 0.0) ? wall_time() + problem->time_budget : 0.0;
+  for(w = 0;w < problem->n_threads;w++)
+  {
+    sampler[w].problem = problem;
+    sampler[w].lock = &lock;
+    sampler[w].next_chunk = &next_chunk;
+    sampler[w].n_samples = problem->n_samples;
+    sampler[w].deadline = deadline;
+    sampler[w].seed = ((uint64_t)problem->NMec << 32) ^ ((uint64_t)problem->T << 16) ^ (uint64_t)problem->P;
+    sampler[w].drawn = 0;
+    sampler[w].valid = 0;
+    sampler[w].best_total_profit = -1;
+    sampler[w].best_chunk = -1;
+    sampler[w].best_assigned_to = (int *)malloc((size_t)(2 * problem->T + problem->P) * sizeof(int));
+    if(sampler[w].best_assigned_to == NULL)
+    {
+      fprintf(stderr,"Strange! Unable to allocate memory\n");
+      exit(1);
+    }
+    sampler[w].assigned_to = sampler[w].best_assigned_to + problem->T;
+    sampler[w].busy = sampler[w].assigned_to + problem->T;
+    for(i = 0;i < problem->T;i++)
+      sampler[w].best_assigned_to[i] = -1;
+    if(pthread_create(&sampler[w].thread,NULL,sampler_thread,&sampler[w]) != 0)
+    {
+      fprintf(stderr,"Unable to create thread %d\n",w);
+      exit(1);
+    }
+  }
+  for(w = 0;w < problem->n_threads;w++)
+    pthread_join(sampler[w].thread,NULL);
+  pthread_mutex_destroy(&lock);
+  //
+  // reduce
+  //
+  best = 0;
+  problem->valid_tasks = 0;
+  problem->n_drawn = 0;
+  for(w = 0;w < problem->n_threads;w++)
+  {
+    problem->valid_tasks += sampler[w].valid;
+    problem->n_drawn += sampler[w].drawn;
+    if(sampler[w].best_total_profit > sampler[best].best_total_profit ||
+       (sampler[w].best_total_profit == sampler[best].best_total_profit && sampler[w].best_chunk < sampler[best].best_chunk))
+      best = w;
+  }
+  problem->best_total_profit = sampler[best].best_total_profit;
+  for(i = 0;i < problem->T;i++)
+    problem->task[i].best_assigned_to = sampler[best].best_assigned_to[i];
+  for(w = 0;w < problem->n_threads;w++)
+    free(sampler[w].best_assigned_to);
+  free(sampler);
+}
+
+//
+// anytime local search (simulated annealing)
+//
+// Starts from the greedy solution of gen2() (or, with -random_start, from a random feasible one) and applies random
+// moves until the wall time budget (-time seconds, 1 second if not given) is exhausted:
+// * add/swap: an unassigned task is given to a random programmer, and the tasks of that programmer that overlap it
+//   are unassigned (none for a plain add);
+// * drop: an assigned task is unassigned;
+// * reassign: an assigned task moves to another programmer that is idle during the whole task.
+// A move that does not lower the profit is always accepted, otherwise it is accepted with probability
+// exp(delta/temperature); the temperature decreases geometrically, with the elapsed time, from the average profit of
+// a task to a thousandth of it. For each programmer and date the task being done (if any) is kept, so a move costs
+// the number of dates of the task, and the memory grows with P times the number of dates. Only the distinct starting
+// dates are used (as in bitmask_enumeration()): a task occupies the starting dates from its own to the last one not
+// after its ending date, so two tasks overlap if and only if they share one of them, there are at most T dates
+// whatever the span of the instance, and the memory is at most P*T. The elapsed
+// time and the profit of each improvement of the best solution are recorded (and saved in the solution file). As
+// the cost of a move depends on the span of its task, the clock is read after a fixed amount of work (the dates
+// scanned by the moves, plus T for each copy of an improved solution), not after a fixed number of moves.
+//
+
+#define LS_CHECK_WORK  65536  // the clock is read once the moves scanned about LS_CHECK_WORK dates (or tasks)
+
+static void record_improvement(problem_t *problem,double time,int profit)
+{
+  if(problem->n_improvements % 64 == 0)
+  {
+    problem->improvement_time = (double *)realloc(problem->improvement_time,(size_t)(problem->n_improvements + 64) * sizeof(double));
+    problem->improvement_profit = (int *)realloc(problem->improvement_profit,(size_t)(problem->n_improvements + 64) * sizeof(int));
+    if(problem->improvement_time == NULL || problem->improvement_profit == NULL)
+    {
+      fprintf(stderr,"Strange! Unable to allocate memory\n");
+      exit(1);
+    }
+  }
+  problem->improvement_time[problem->n_improvements] = time;
+  problem->improvement_profit[problem->n_improvements] = profit;
+  problem->n_improvements++;
+}
+
+static int compare_tasks_2_stable(const void *t1,const void *t2)
+{ // compare_tasks_2(), and then the position of the task (kept in assigned_to), as in a stable sort
+  int c = compare_tasks_2(t1,t2);
+
+  if(c != 0)
+    return c;
+  return (((task_t *)t1)->assigned_to < ((task_t *)t2)->assigned_to) ? -1 : +1;
+}
+
+void local_search(problem_t *problem)
+{
+  int T = problem->T,P = problem->P,i,j,k,p,d,delta,profit,best_profit,n_dates,n_ejected;
+  long long work;
+  int *busy,*assigned_to,*owner,*ejected,*first_date,*last_date,lo,hi;
+  task_t *sorted;
+  uint64_t r;
+  double start,elapsed,budget,temperature,t0,t1,sum;
+  stream_t stream;
+
+  start = wall_time();
+  budget = (problem->time_budget > 0.0) ? problem->time_budget : 1.0;
+  stream_start(&stream,((uint64_t)problem->NMec << 32) ^ ((uint64_t)problem->T << 16) ^ (uint64_t)problem->P,0);
+  problem->n_moves = 0;
+  problem->n_accepted = 0;
+  problem->n_improvements = 0;
+  problem->improvement_time = NULL;
+  problem->improvement_profit = NULL;
+  busy = (int *)malloc((size_t)P * sizeof(int));
+  assigned_to = (int *)malloc((size_t)T * sizeof(int));
+  ejected = (int *)malloc((size_t)T * sizeof(int));
+  first_date = (int *)malloc((size_t)T * 2 * sizeof(int));
+  sorted = (task_t *)malloc((size_t)T * sizeof(task_t));
+  if(busy == NULL || assigned_to == NULL || ejected == NULL || first_date == NULL || sorted == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  last_date = first_date + T;
+  //
+  // the dates of task i are first_date[i],...,last_date[i] (the tasks are sorted by starting date)
+  //
+  n_dates = 0;
+  sum = 0.0;
+  for(i = 0;i < T;i++)
+  {
+    if(i > 0 && problem->task[i].starting_date != problem->task[i - 1].starting_date)
+      n_dates++;
+    first_date[i] = n_dates;
+    sum += (double)problem->task[i].profit;
+  }
+  n_dates++;
+  for(i = 0;i < T;i++)
+  {
+    for(lo = i + 1,hi = T;lo < hi;) // the first task that starts after the end of task i
+      if(problem->task[(lo + hi) / 2].starting_date > problem->task[i].ending_date)
+        hi = (lo + hi) / 2;
+      else
+        lo = (lo + hi) / 2 + 1;
+    last_date[i] = first_date[lo - 1];
+  }
+  owner = (int *)malloc((size_t)P * (size_t)n_dates * sizeof(int));
+  if(owner == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+#define OWNER(p,d)  owner[(size_t)(p) * (size_t)n_dates + (size_t)(d)]
+  //
+  // initial solution
+  //
+  for(p = 0;p < P;p++)
+    busy[p] = -1;
+  for(i = 0;i < T;i++)
+    assigned_to[i] = -1;
+  if(problem->random_start == 0)
+  { // gen2(): programmer after programmer, the remaining tasks by ending date
+    for(i = 0;i < T;i++)
+    {
+      sorted[i] = problem->task[i];
+      sorted[i].assigned_to = i; // the copy remembers the position of the task in the problem->task[] array
+    }
+    qsort((void *)sorted,(size_t)T,sizeof(sorted[0]),compare_tasks_2_stable);
+    for(p = 0;p < P;p++)
+      for(k = 0;k < T;k++)
+        if(assigned_to[sorted[k].assigned_to] < 0 && busy[p] < sorted[k].starting_date)
+        {
+          assigned_to[sorted[k].assigned_to] = p;
+          busy[p] = sorted[k].ending_date;
+        }
+  }
+  else
+  { // each task that has an idle programmer is chosen with probability 1/2
+    r = 0;
+    for(i = 0;i < T;i++)
+    {
+      if((i & 63) == 0)
+        r = stream_next(&stream);
+      for(p = 0;p < P;p++)
+        if(busy[p] < problem->task[i].starting_date)
+          break;
+      if(p < P && ((r >> (i & 63)) & 1) != 0)
+      {
+        assigned_to[i] = p;
+        busy[p] = problem->task[i].ending_date;
+      }
+    }
+  }
+  for(p = 0;p < P;p++)
+    for(d = 0;d < n_dates;d++)
+      OWNER(p,d) = -1;
+  profit = 0;
+  for(i = 0;i < T;i++)
+    if(assigned_to[i] >= 0)
+    {
+      for(d = first_date[i];d <= last_date[i];d++)
+        OWNER(assigned_to[i],d) = i;
+      profit += problem->task[i].profit;
+    }
+  best_profit = profit;
+  for(i = 0;i < T;i++)
+    problem->task[i].best_assigned_to = assigned_to[i];
+  record_improvement(problem,wall_time() - start,best_profit);
+  //
+  // simulated annealing
+  //
+  t0 = sum / (double)T;
+  t1 = t0 / 1000.0;
+  temperature = t0;
+  work = LS_CHECK_WORK; // read the clock before the first move
+  for(;;problem->n_moves++)
+  {
+    if(work >= LS_CHECK_WORK)
+    {
+      work = 0;
+      elapsed = wall_time() - start;
+      if(elapsed >= budget)
+        break;
+      temperature = t0 * pow(t1 / t0,elapsed / budget);
+    }
+    r = stream_next(&stream);
+    i = (int)((r >> 8) % (uint64_t)T);
+    p = (int)((r >> 40) % (uint64_t)P);
+    work += 1 + last_date[i] - first_date[i];
+    n_ejected = 0;
+    if(assigned_to[i] < 0)
+    { // add/swap (the tasks of a programmer do not overlap, so each one occupies consecutive dates)
+      delta = problem->task[i].profit;
+      for(d = first_date[i];d <= last_date[i];d++)
+        if(OWNER(p,d) >= 0 && (n_ejected == 0 || ejected[n_ejected - 1] != OWNER(p,d)))
+        {
+          ejected[n_ejected++] = OWNER(p,d);
+          delta -= problem->task[OWNER(p,d)].profit;
+        }
+    }
+    else if((r & 1) != 0)
+    { // drop
+      delta = -problem->task[i].profit;
+      p = -1;
+    }
+    else
+    { // reassign
+      if(p == assigned_to[i])
+        continue;
+      for(d = first_date[i];d <= last_date[i] && OWNER(p,d) < 0;d++)
+        ;
+      if(d <= last_date[i])
+        continue;
+      delta = 0;
+    }
+    if(delta < 0 && (double)(stream_next(&stream) >> 11) * 0x1.0p-53 >= exp((double)delta / temperature))
+      continue;
+    //
+    // apply the move
+    //
+    problem->n_accepted++;
+    for(k = 0;k < n_ejected;k++)
+    {
+      j = ejected[k];
+      for(d = first_date[j];d <= last_date[j];d++)
+        OWNER(p,d) = -1;
+      assigned_to[j] = -1;
+    }
+    if(assigned_to[i] >= 0)
+      for(d = first_date[i];d <= last_date[i];d++)
+        OWNER(assigned_to[i],d) = -1;
+    if(p >= 0)
+      for(d = first_date[i];d <= last_date[i];d++)
+        OWNER(p,d) = i;
+    assigned_to[i] = p;
+    profit += delta;
+    if(profit > best_profit)
+    {
+      best_profit = profit;
+      for(j = 0;j < T;j++)
+        problem->task[j].best_assigned_to = assigned_to[j];
+      work += T;
+      record_improvement(problem,wall_time() - start,best_profit);
+    }
+  }
+#undef OWNER
+  problem->best_total_profit = best_profit;
+  problem->valid_tasks = -1; // not counted
+  free(busy);
+  free(assigned_to);
+  free(ejected);
+  free(owner);
+  free(first_date);
+  free(sorted);
+}
+
+//
+// checkpointed enumeration
+//
+// The search of generate_possibilities() (same order of the subsets, so the same results), but every -checkpoint
+// seconds (60 by default) the state of the search is saved in the file <solution file>.ckpt: the decisions (task not
+// done/done) that lead to the current leaf, valid_tasks, the best solution and the histogram (only its nonzero
+// entries). The file is written with another name and then renamed, so a killed program leaves either the previous
+// checkpoint or the new one. With -resume the search restarts from the checkpoint: the decisions of the saved leaf
+// are followed, skipping the subtrees to the left of that path (already enumerated) and the saved leaf itself. The
+// hot path only decrements a counter; the clock is read once every CHECKPOINT_LEAVES leaves. The checkpoint file is
+// removed when the search finishes.
+//
+
+#define CHECKPOINT_LEAVES  (1 << 20)
+#define CHECKPOINT_MAGIC   0x4B434A53u  // "SJCK"
+
+typedef struct
+{
+  problem_t *problem;
+  char decision[SEARCH_MAX_T];         // decisions of the current path (1 means that the task is done)
+  char resume_decision[SEARCH_MAX_T];  // decisions of the path of the checkpoint
+  int resuming;                        // 1 while the path of the checkpoint is being followed
+  long long countdown;                 // number of leaves until the clock is read
+  double next_checkpoint;              // wall time of the next checkpoint
+  char file_name[80];
+}
+checkpoint_t;
+
+static uint32_t task_checksum(problem_t *problem)
+{ // FNV-1a of the task data, to detect the checkpoints of other instances
+  uint32_t h = 2166136261u;
+  int i;
+
+  for(i = 0;i < problem->T;i++)
+  {
+    h = (h ^ (uint32_t)problem->task[i].starting_date) * 16777619u;
+    h = (h ^ (uint32_t)problem->task[i].ending_date) * 16777619u;
+    h = (h ^ (uint32_t)problem->task[i].profit) * 16777619u;
+  }
+  return h;
+}
+
+static void write_checkpoint(checkpoint_t *ck)
+{
+  problem_t *problem = ck->problem;
+  char tmp_name[96];
+  int32_t header[7],pair[2],n_nonzero,i,ok;
+  FILE *fp;
+
+  snprintf(tmp_name,sizeof(tmp_name),"%s.tmp",ck->file_name);
+  fp = fopen(tmp_name,"wb");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"Unable to create the checkpoint file %s\n",tmp_name);
+    return; // the search goes on without this checkpoint
+  }
+  n_nonzero = 0;
+  for(i = 0;i <= problem->sum_all_tasks;i++)
+    if(problem->valid_tasks_profits[i] != 0)
+      n_nonzero++;
+  header[0] = (int32_t)CHECKPOINT_MAGIC;
+  header[1] = (int32_t)task_checksum(problem);
+  header[2] = problem->NMec;
+  header[3] = problem->T;
+  header[4] = problem->P;
+  header[5] = problem->best_total_profit;
+  header[6] = n_nonzero;
+#define WRITE(data,n)  ok &= (fwrite((void *)(data),sizeof(*(data)),(size_t)(n),fp) == (size_t)(n)) ? 1 : 0
+  ok = 1;
+  WRITE(header,7);
+  WRITE(&problem->valid_tasks,1);
+  WRITE(ck->decision,problem->T);
+  for(i = 0;i < problem->T;i++)
+    WRITE(&problem->task[i].best_assigned_to,1);
+  for(i = 0;i <= problem->sum_all_tasks;i++)
+    if(problem->valid_tasks_profits[i] != 0)
+    {
+      pair[0] = i;
+      pair[1] = problem->valid_tasks_profits[i];
+      WRITE(pair,2);
+    }
+#undef WRITE
+  if(fclose(fp) != 0 || ok == 0 || rename(tmp_name,ck->file_name) != 0)
+    fprintf(stderr,"Error while writing the checkpoint file %s\n",ck->file_name);
+}
+
+static int read_checkpoint(checkpoint_t *ck)
+{
+  problem_t *problem = ck->problem;
+  int32_t header[7],pair[2],i,ok;
+  FILE *fp;
+
+  fp = fopen(ck->file_name,"rb");
+  if(fp == NULL)
+    return 0; // nothing to resume
+#define READ(data,n)  ok &= (fread((void *)(data),sizeof(*(data)),(size_t)(n),fp) == (size_t)(n)) ? 1 : 0
+  ok = 1;
+  READ(header,7);
+  if(ok == 0 || header[0] != (int32_t)CHECKPOINT_MAGIC || header[1] != (int32_t)task_checksum(problem) ||
+     header[2] != problem->NMec || header[3] != problem->T || header[4] != problem->P)
+  {
+    fprintf(stderr,"The checkpoint file %s does not belong to this instance\n",ck->file_name);
+    exit(1);
+  }
+  problem->best_total_profit = header[5];
+  READ(&problem->valid_tasks,1);
+  READ(ck->resume_decision,problem->T);
+  for(i = 0;i < problem->T;i++)
+    READ(&problem->task[i].best_assigned_to,1);
+  for(i = 0;i < header[6] && ok != 0;i++)
+  {
+    READ(pair,2);
+    if(ok != 0 && (pair[0] < 0 || pair[0] > problem->sum_all_tasks))
+      ok = 0;
+    else if(ok != 0)
+      problem->valid_tasks_profits[pair[0]] = pair[1];
+  }
+#undef READ
+  fclose(fp);
+  if(ok == 0)
+  {
+    fprintf(stderr,"The checkpoint file %s is corrupted\n",ck->file_name);
+    exit(1);
+  }
+  return 1;
+}
+
+static void checkpointed_search(checkpoint_t *ck,int t)
+{
+  problem_t *problem = ck->problem;
+  int i,j,busy_copy;
+
+  if(t == problem->T)
+  {
+    if(ck->resuming != 0)
+    { // the leaf of the checkpoint was already counted
+      ck->resuming = 0;
+      return;
+    }
+    problem->valid_tasks++;
+    problem->valid_tasks_profits[problem->total_profit]++;
+    if(problem->total_profit > problem->best_total_profit)
+    {
+      problem->best_total_profit = problem->total_profit;
+      for(j = 0;j < problem->T;j++)
+        problem->task[j].best_assigned_to = problem->task[j].assigned_to;
+    }
+    if(--ck->countdown == 0)
+    {
+      ck->countdown = CHECKPOINT_LEAVES;
+      if(wall_time() >= ck->next_checkpoint)
+      {
+        write_checkpoint(ck);
+        ck->next_checkpoint = wall_time() + problem->checkpoint_interval;
+      }
+    }
+    return;
+  }
+  //
+  // task t not done
+  //
+  if(ck->resuming == 0 || ck->resume_decision[t] == 0)
+  {
+    ck->decision[t] = 0;
+    checkpointed_search(ck,t + 1);
+  }
+  //
+  // task t done by the first idle programmer
+  //
+  for(i = 0;i < problem->P;i++)
+    if(problem->busy[i] < problem->task[t].starting_date)
+      break;
+  if(i == problem->P)
+    return;
+  busy_copy = problem->busy[i];
+  problem->busy[i] = problem->task[t].ending_date;
+  problem->task[t].assigned_to = i;
+  problem->total_profit += problem->task[t].profit;
+  ck->decision[t] = 1;
+  checkpointed_search(ck,t + 1);
+  problem->total_profit -= problem->task[t].profit;
+  problem->task[t].assigned_to = -1;
+  problem->busy[i] = busy_copy;
+}
+
+void checkpointed_enumeration(problem_t *problem)
+{
+  checkpoint_t *ck; // one per call, for the workers of -batch
+  int i;
+
+  problem->best_total_profit = 0;
+  problem->valid_tasks = 0;
+  problem->total_profit = 0;
+  problem->sum_all_tasks = 0;
+  for(i = 0;i < problem->T;i++)
+  {
+    problem->task[i].assigned_to = -1;
+    problem->sum_all_tasks += problem->task[i].profit;
+  }
+  for(i = 0;i < problem->P;i++)
+    problem->busy[i] = -1;
+  problem->valid_tasks_profits = (int *)calloc((size_t)(problem->sum_all_tasks + 1),sizeof(int));
+  if(problem->valid_tasks_profits == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  ck = (checkpoint_t *)malloc(sizeof(checkpoint_t));
+  if(ck == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  ck->problem = problem;
+  if(snprintf(ck->file_name,sizeof(ck->file_name),"%s.ckpt",problem->file_name) >= (int)sizeof(ck->file_name))
+  {
+    fprintf(stderr,"File name too large!\n");
+    exit(1);
+  }
+  ck->resuming = 0;
+  problem->resumed = 0;
+  if(problem->resume != 0 && read_checkpoint(ck) != 0)
+    ck->resuming = problem->resumed = 1;
+  ck->countdown = CHECKPOINT_LEAVES;
+  ck->next_checkpoint = wall_time() + problem->checkpoint_interval;
+  checkpointed_search(ck,0);
+  (void)remove(ck->file_name);
+  free(ck);
+}
+
+//
+// structure of arrays enumeration
+//
+// The search of generate_possibilities() (same order of the subsets, so the same results) with the task data split
+// in separate arrays (starting dates, ending dates, profits), so that the data used by the search is contiguous,
+// and with the first idle programmer found by first_idle(). Compiled with -DSIMD_FIRST_IDLE, first_idle() compares
+// FIRST_IDLE_LANES entries of busy[] at once (AVX2 or SSE2, if available); busy[] is then padded with INT_MAX (never
+// idle) to a multiple of FIRST_IDLE_LANES. The SIMD kernel is not the default because for P <= 10 it is slower than
+// the scalar loop (T=26, P=1..10: 15% to 65% slower): the scalar loop usually stops at one of the first entries, and
+// the vector load of busy[] right after the store of one of its entries cannot be forwarded from the store buffer.
+//
+
+typedef struct
+{
+  int T;
+  int n_busy;             // P rounded up to a multiple of FIRST_IDLE_LANES
+  int *starting_date;     // task data (T entries each)
+  int *ending_date;
+  int *profit;
+  int *assigned_to;
+  int *busy;              // n_busy entries
+  int *best_assigned_to;
+  int best_total_profit;
+  long long valid_tasks;
+  int *valid_tasks_profits;
+#ifdef SEARCH_STATS
+  search_stats_t *stats;
+#endif
+}
+soa_t;
+
+static inline int first_idle(const int *busy,int n_busy,int date)
+{ // index of the first entry of busy[] smaller than date, or -1 (n_busy must be a multiple of FIRST_IDLE_LANES)
+  int i;
+#if FIRST_IDLE_LANES == 8
+  __m256i d = _mm256_set1_epi32(date);
+  int mask;
+
+  for(i = 0;i < n_busy;i += 8)
+  {
+    mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(d,
+                                                                     _mm256_loadu_si256((const __m256i *)&busy[i]))));
+    if(mask != 0)
+      return i + ctz64((uint64_t)mask);
+  }
+#elif FIRST_IDLE_LANES == 4
+  __m128i d = _mm_set1_epi32(date);
+  int mask;
+
+  for(i = 0;i < n_busy;i += 4)
+  {
+    mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(d,_mm_loadu_si128((const __m128i *)&busy[i]))));
+    if(mask != 0)
+      return i + ctz64((uint64_t)mask);
+  }
+#else
+  for(i = 0;i < n_busy;i++)
+    if(busy[i] < date)
+      return i;
+#endif
+  return -1;
+}
+
+static inline void soa_leaf(soa_t *s,int total_profit)
+{
+  int i;
+
+  s->valid_tasks++;
+  s->valid_tasks_profits[total_profit]++;
+  STATS_LEAF(s->stats);
+  if(total_profit > s->best_total_profit)
+  {
+    STATS_IMPROVEMENT(s->stats);
+    s->best_total_profit = total_profit;
+    for(i = 0;i < s->T;i++)
+      s->best_assigned_to[i] = s->assigned_to[i];
+  }
+}
+
+static void soa_search(soa_t *s,int t,int total_profit)
+{
+  int i,busy_copy;
+
+  STATS_NODE(s->stats,t);
+  if(t == s->T)
+  {
+    soa_leaf(s,total_profit);
+    return;
+  }
+  // skip the task
+  STATS_DESCEND(s->stats,t + 1);
+  soa_search(s,t + 1,total_profit);
+  STATS_ASCEND(s->stats,t + 1);
+  // do the task (if some programmer is idle)
+  i = first_idle(s->busy,s->n_busy,s->starting_date[t]);
+  if(i < 0)
+  {
+    STATS_INFEASIBLE(s->stats,t);
+    return;
+  }
+  busy_copy = s->busy[i];
+  s->busy[i] = s->ending_date[t];
+  s->assigned_to[t] = i;
+  STATS_DESCEND(s->stats,t + 1);
+  soa_search(s,t + 1,total_profit + s->profit[t]);
+  STATS_ASCEND(s->stats,t + 1);
+  s->assigned_to[t] = -1;
+  s->busy[i] = busy_copy;
+}
+
+static void specialized_search(soa_t *s,int P);
+
+static void soa_solve(problem_t *problem,int specialized)
+{
+  soa_t s;
+  int i,T = problem->T;
+
+  s.T = T;
+  s.n_busy = (problem->P + FIRST_IDLE_LANES - 1) / FIRST_IDLE_LANES * FIRST_IDLE_LANES;
+  s.starting_date = (int *)malloc((size_t)(5 * T + s.n_busy) * sizeof(int));
+  if(s.starting_date == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  s.ending_date = s.starting_date + T;
+  s.profit = s.ending_date + T;
+  s.assigned_to = s.profit + T;
+  s.best_assigned_to = s.assigned_to + T;
+  s.busy = s.best_assigned_to + T;
+  problem->sum_all_tasks = 0;
+  for(i = 0;i < T;i++)
+  {
+    s.starting_date[i] = problem->task[i].starting_date;
+    s.ending_date[i] = problem->task[i].ending_date;
+    s.profit[i] = problem->task[i].profit;
+    s.assigned_to[i] = -1;
+    s.best_assigned_to[i] = -1;
+    problem->sum_all_tasks += problem->task[i].profit;
+  }
+  for(i = 0;i < s.n_busy;i++)
+    s.busy[i] = (i < problem->P) ? -1 : INT_MAX;
+  s.best_total_profit = 0;
+#ifdef SEARCH_STATS
+  s.stats = problem->stats;
+#endif
+  s.valid_tasks = 0;
+  s.valid_tasks_profits = (int *)calloc((size_t)(problem->sum_all_tasks + 1),sizeof(int));
+  if(s.valid_tasks_profits == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  if(specialized != 0)
+    specialized_search(&s,problem->P);
+  else
+    soa_search(&s,0,0);
+  problem->best_total_profit = s.best_total_profit;
+  problem->valid_tasks = s.valid_tasks;
+  problem->valid_tasks_profits = s.valid_tasks_profits;
+  for(i = 0;i < T;i++)
+    problem->task[i].best_assigned_to = s.best_assigned_to[i];
+  free(s.starting_date);
+}
+
+void soa_enumeration(problem_t *problem)
+{
+  soa_solve(problem,0);
+}
+
+//
+// enumeration specialized for each number of programmers
+//
+// soa_search() with the number of programmers known at compile time: for each P = 1,2,...,10 the macro
+// SPECIALIZED_SEARCH generates a search whose scan for an idle programmer has a constant trip count (so the compiler
+// can unroll it) over a fixed size busy[] that is a local array of specialized_search() instead of heap memory.
+// specialized_search() dispatches on P; larger values of P use soa_search(). Same order of the subsets, so the same
+// results, as generate_possibilities(). (Passing busy[] by value, as a struct, was also tried; it is faster only for
+// P = 2 and slower for P = 6,7,8,10.)
+//
+
+#define SPECIALIZED_SEARCH(n)                                                                               \
+  static void specialized_search_##n(soa_t *s,int t,int total_profit,int *busy)                             \
+  {                                                                                                         \
+    int i,busy_copy;                                                                                        \
+                                                                                                            \
+    STATS_NODE(s->stats,t);                                                                                 \
+    if(t == s->T)                                                                                           \
+    {                                                                                                       \
+      soa_leaf(s,total_profit);                                                                             \
+      return;                                                                                               \
+    }                                                                                                       \
+    STATS_DESCEND(s->stats,t + 1);                                                                          \
+    specialized_search_##n(s,t + 1,total_profit,busy);                                                      \
+    STATS_ASCEND(s->stats,t + 1);                                                                           \
+    for(i = 0;i < n;i++)                                                                                    \
+      if(busy[i] < s->starting_date[t])                                                                     \
+      {                                                                                                     \
+        busy_copy = busy[i];                                                                                \
+        busy[i] = s->ending_date[t];                                                                        \
+        s->assigned_to[t] = i;                                                                              \
+        STATS_DESCEND(s->stats,t + 1);                                                                      \
+        specialized_search_##n(s,t + 1,total_profit + s->profit[t],busy);                                   \
+        STATS_ASCEND(s->stats,t + 1);                                                                       \
+        s->assigned_to[t] = -1;                                                                             \
+        busy[i] = busy_copy;                                                                                \
+        return;                                                                                             \
+      }                                                                                                     \
+    STATS_INFEASIBLE(s->stats,t);                                                                           \
+  }
+SPECIALIZED_SEARCH(1)
+SPECIALIZED_SEARCH(2)
+SPECIALIZED_SEARCH(3)
+SPECIALIZED_SEARCH(4)
+SPECIALIZED_SEARCH(5)
+SPECIALIZED_SEARCH(6)
+SPECIALIZED_SEARCH(7)
+SPECIALIZED_SEARCH(8)
+SPECIALIZED_SEARCH(9)
+SPECIALIZED_SEARCH(10)
+#undef SPECIALIZED_SEARCH
+
+static void specialized_search(soa_t *s,int P)
+{
+  switch(P)
+  {
+#define SPECIALIZED_CASE(n)                                                                                 \
+    case n:                                                                                                 \
+      {                                                                                                     \
+        int busy[n],i;                                                                                      \
+                                                                                                            \
+        for(i = 0;i < n;i++)                                                                                \
+          busy[i] = -1;                                                                                     \
+        specialized_search_##n(s,0,0,busy);                                                                 \
+      }                                                                                                     \
+      break
+    SPECIALIZED_CASE(1);
+    SPECIALIZED_CASE(2);
+    SPECIALIZED_CASE(3);
+    SPECIALIZED_CASE(4);
+    SPECIALIZED_CASE(5);
+    SPECIALIZED_CASE(6);
+    SPECIALIZED_CASE(7);
+    SPECIALIZED_CASE(8);
+    SPECIALIZED_CASE(9);
+    SPECIALIZED_CASE(10);
+#undef SPECIALIZED_CASE
+    default:
+      soa_search(s,0,0);
+      break;
+  }
+}
+
+void specialized_enumeration(problem_t *problem)
+{
+  soa_solve(problem,1);
+}
+
+//
+// solvers that can be used by solve() (selected by the fifth command line argument)
+//
+
+typedef void (*solver_function_t)(problem_t *problem);
+
+void timeline_decomposition(problem_t *problem);
+
+static void run_dumb_approach(problem_t *problem)
+{
+  int arr[problem->T];
+
+  problem->best_total_profit = 0;
+  problem->valid_tasks = 0;
+  problem->total_profit = 0;
+  for(int i = 0;i < problem->P;i++)
+    problem->busy[i] = -1;
+  for(int i = 0;i < problem->T;i++)
+    problem->task[i].assigned_to = -1;
+  dumb_approach(problem,arr,1);
+}
+
+static void run_generate_possibilities(problem_t *problem)
+{
+  generate_possibilities(problem,0);
+}
+
+static void run_branch_and_bound(problem_t *problem)
+{
+  init_branch_and_bound(problem,1);
+  branch_and_bound(problem,0);
+  if(problem->best_total_profit < problem->incumbent_profit)
+  { // only possible if the deadline was reached
+    init_branch_and_bound(problem,0);
+    problem->best_total_profit = problem->incumbent_profit;
+  }
+  if(problem->upper_bound < problem->best_total_profit)
+    problem->upper_bound = problem->best_total_profit;
+}
+
+static struct
+{
+  solver_function_t function;
+  char *name;
+  int max_T;                    // largest number of tasks it can handle
+  int max_P;                    // largest number of programmers it can handle
+  int exact;                    // 1 if it always finds the best profit
+}
+solvers[] =
+{
+  { run_dumb_approach         ,"dumb_approach"           ,SEARCH_MAX_T,MAX_P       ,0 },
+  { run_generate_possibilities,"generate_possibilities"  ,SEARCH_MAX_T,MAX_P       ,1 },
+  { gen2                      ,"gen2"                    ,MAX_T       ,MAX_P       ,0 },  // only to find the maximum number of tasks
+  { random_approach           ,"random_approach"         ,MAX_T       ,MAX_P       ,0 },
+  { run_branch_and_bound      ,"branch_and_bound"        ,SEARCH_MAX_T,MAX_P       ,1 },
+  { min_cost_flow             ,"min_cost_flow"           ,FILE_MAX_T  ,MAX_P       ,1 },
+  { weighted_interval_dp      ,"weighted_interval_dp"    ,FILE_MAX_T  ,MAX_P       ,1 },  // P = 1 only (otherwise uses min_cost_flow)
+  { parallel_enumeration      ,"parallel_enumeration"    ,SEARCH_MAX_T,SEARCH_MAX_P,1 },
+  { bitmask_enumeration       ,"bitmask_enumeration"     ,SEARCH_MAX_T,MAX_P       ,1 },
+  { timeline_decomposition    ,"timeline_decomposition"  ,MAX_T       ,MAX_P       ,1 },  // each block is solved by the -inner solver
+  { reduced_enumeration       ,"reduced_enumeration"     ,SEARCH_MAX_T,SEARCH_MAX_P,1 },
+  { histogram_sweep           ,"histogram_sweep"         ,MAX_T       ,SEARCH_MAX_P,1 },
+  { parallel_sampler          ,"parallel_sampler"        ,MAX_T       ,MAX_P       ,0 },
+  { local_search              ,"local_search"            ,MAX_T       ,MAX_P       ,0 },
+  { checkpointed_enumeration  ,"checkpointed_enumeration",SEARCH_MAX_T,MAX_P       ,1 },
+  { soa_enumeration           ,"soa_enumeration"         ,SEARCH_MAX_T,MAX_P       ,1 },
+  { specialized_enumeration   ,"specialized_enumeration" ,SEARCH_MAX_T,MAX_P       ,1 },  // P > 10 uses soa_enumeration
+  { max_tasks                 ,"max_tasks"               ,FILE_MAX_T  ,MAX_P       ,0 },  // exact only if the profits are ignored
+  { top_k_enumeration         ,"top_k_enumeration"       ,SEARCH_MAX_T,MAX_P       ,1 }   // the -top best subsets of tasks
+};
+#define N_SOLVERS     (int)(sizeof(solvers) / sizeof(solvers[0]))
+#define DEFAULT_SOLVER  3  // random_approach
+
+static void check_solver_limits(problem_t *problem)
+{
+  if(problem->T > solvers[problem->solver].max_T || problem->P > solvers[problem->solver].max_P)
+  {
+    fprintf(stderr,"The solver %s only handles T <= %d and P <= %d (T = %d, P = %d)\n",solvers[problem->solver].name,
+            solvers[problem->solver].max_T,solvers[problem->solver].max_P,problem->T,problem->P);
+    exit(1);
+  }
+}
+
+//
+// timeline decomposition
+//
+// The tasks are sorted by starting date; when all tasks 0,1,...,i end before task i+1 starts, no programmer can be
+// busy with tasks of both sides, so the tasks 0..i and i+1..T-1 can be solved independently (all programmers are
+// idle at the cut). Each block is solved with the inner solver, and the results are combined:
+// * the best profit is the sum of the best profits of the blocks, and the best assignment is the union of theirs,
+// * the number of valid assignments is the product of those of the blocks,
+// * the histogram of the profits is the convolution of those of the blocks.
+// The last two are only available if the inner solver counts the valid assignments (and fills the histogram). If the
+// product does not fit in a long long the valid assignments are not counted (valid_tasks is -1), and if it does not
+// fit in an int the histogram is dropped (its entries, and the products of the convolution, are at most the product);
+// it is also dropped if the sum of the profits does not fit in an int. Each block gets the options of the problem,
+// and a -deadline is shared by all blocks: each one gets the time that remains (and the upper bound and the stopped
+// flag of the problem combine those of the blocks).
+// Each block is written to the file of the instance followed by .<block number> (so that the checkpoint files of the
+// checkpointed enumeration of different blocks do not collide).
+//
+
+void timeline_decomposition(problem_t *problem)
+{
+  problem_t block;
+  int first,one_after_last,last_end,i,j,k,n,*histogram,*new_histogram;
+  long long sum,sum_all_tasks;
+  char *used;
+
+  if(solvers[problem->inner_solver].function == timeline_decomposition)
+  {
+    fprintf(stderr,"The inner solver of timeline_decomposition cannot be itself\n");
+    exit(1);
+  }
+  problem->best_total_profit = 0;
+  problem->valid_tasks = 1;
+  problem->n_blocks = 0;
+  problem->stop_time = (problem->deadline > 0.0) ? wall_time() + problem->deadline : 0.0;
+  problem->stopped = 0;
+  problem->upper_bound = 0;
+  sum_all_tasks = 0;
+  histogram = (int *)calloc(1,sizeof(int)); // the histogram of zero tasks
+  if(histogram == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  histogram[0] = 1;
+  for(first = 0;first < problem->T;first = one_after_last)
+  {
+    //
+    // find the next block
+    //
+    last_end = problem->task[first].ending_date;
+    for(one_after_last = first + 1;one_after_last < problem->T;one_after_last++)
+      if(problem->task[one_after_last].starting_date > last_end)
+        break;
+      else if(problem->task[one_after_last].ending_date > last_end)
+        last_end = problem->task[one_after_last].ending_date;
+    problem->n_blocks++;
+    //
+    // solve it
+    //
+    block = *problem; // all the options of the problem (the arrays and the results are replaced below)
+    block.T = one_after_last - first;
+    block.solver = problem->inner_solver;
+    block.valid_tasks_profits = NULL;
+    block.histogram_profit = NULL;
+    block.histogram_count = NULL;
+    block.improvement_time = NULL;
+    block.improvement_profit = NULL;
+    block.top = NULL;
+#ifdef SEARCH_STATS
+    block.stats = NULL;
+#endif
+    block.stopped = 0;
+    block.upper_bound = 0;
+    if(problem->stop_time > 0.0)
+    { // the time that remains (a tiny positive one, if none, so that the deadline is not removed)
+      block.deadline = problem->stop_time - wall_time();
+      if(block.deadline < 1.0e-6)
+        block.deadline = 1.0e-6;
+    }
+    if(snprintf(block.file_name,sizeof(block.file_name),"%s.%d",problem->file_name,problem->n_blocks) >=
+       (int)sizeof(block.file_name))
+    {
+      fprintf(stderr,"File name too large!\n");
+      exit(1);
+    }
+    check_solver_limits(&block);
+    alloc_problem(&block,block.T,block.P);
+    for(i = 0;i < block.T;i++)
+      block.task[i] = problem->task[first + i];
+    (*solvers[block.solver].function)(&block);
+    //
+    // some solvers reorder the tasks, so each task of the block is matched with an equal one of the solved block
+    //
+    for(i = first;i < one_after_last;i++)
+      if(block.task[i - first].starting_date != problem->task[i].starting_date ||
+         block.task[i - first].ending_date != problem->task[i].ending_date ||
+         block.task[i - first].profit != problem->task[i].profit)
+        break;
+    if(i == one_after_last)
+      for(i = first;i < one_after_last;i++)
+        problem->task[i].best_assigned_to = block.task[i - first].best_assigned_to;
+    else
+    {
+      used = (char *)calloc((size_t)block.T,sizeof(char));
+      if(used == NULL)
+      {
+        fprintf(stderr,"Strange! Unable to allocate memory\n");
+        exit(1);
+      }
+      for(i = first;i < one_after_last;i++)
+      {
+        for(j = 0;j < block.T;j++)
+          if(used[j] == 0 && block.task[j].starting_date == problem->task[i].starting_date &&
+             block.task[j].ending_date == problem->task[i].ending_date && block.task[j].profit == problem->task[i].profit)
+            break;
+        used[j] = 1;
+        problem->task[i].best_assigned_to = block.task[j].best_assigned_to;
+      }
+      free(used);
+    }
+    problem->best_total_profit += block.best_total_profit;
+    problem->upper_bound += (block.upper_bound > block.best_total_profit) ? block.upper_bound : block.best_total_profit;
+    if(block.stopped != 0)
+      problem->stopped = 1;
+    //
+    // combine the counts
+    //
+    if(problem->valid_tasks < 0 || block.valid_tasks < 0 ||
+       (block.valid_tasks > 0 && problem->valid_tasks > LLONG_MAX / block.valid_tasks))
+      problem->valid_tasks = -1; // not counted (or too many to count)
+    else
+      problem->valid_tasks *= block.valid_tasks;
+    sum = 0;
+    for(i = 0;i < block.T;i++)
+      sum += (long long)block.task[i].profit;
+    if(histogram != NULL && problem->valid_tasks >= 0 && problem->valid_tasks <= (long long)INT_MAX &&
+       block.valid_tasks_profits != NULL && sum_all_tasks + sum <= (long long)INT_MAX)
+    {
+      new_histogram = (int *)calloc((size_t)(sum_all_tasks + sum + 1),sizeof(int));
+      if(new_histogram == NULL)
+      {
+        fprintf(stderr,"Strange! Unable to allocate memory\n");
+        exit(1);
+      }
+      for(k = 0;k <= sum;k++)
+        if(block.valid_tasks_profits[k] != 0)
+          for(n = 0;n <= (int)sum_all_tasks;n++)
+            if(histogram[n] != 0)
+              new_histogram[n + k] += histogram[n] * block.valid_tasks_profits[k];
+      free(histogram);
+      histogram = new_histogram;
+    }
+    else
+    {
+      free(histogram);
+      histogram = NULL;
+    }
+    sum_all_tasks += sum;
+    free(block.valid_tasks_profits);
+    free(block.histogram_profit);
+    free(block.histogram_count);
+    free(block.improvement_time);
+    free(block.improvement_profit);
+    free(block.top);
+    free_problem(&block);
+  }
+  problem->valid_tasks_profits = histogram;
+  problem->sum_all_tasks = (histogram != NULL) ? (int)sum_all_tasks : 0;
+}
+
+#if 1
+
+static FILE *open_solution_file(problem_t *problem)
+{
+  FILE *fp;
+
+#ifdef _WIN32
+  (void)mkdir(problem->dir_name);//  o de baixo nao me compila em windows
+#else
+  (void)mkdir(problem->dir_name,S_IRUSR | S_IWUSR | S_IXUSR);
+#endif
+  fp = fopen(problem->file_name,"w");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"Unable to create file %s (maybe it already exists? If so, delete it!)\n",problem->file_name);
+    exit(1);
+  }
+  return fp;
+}
+
+static void save_solution(problem_t *problem,FILE *fp)
+{
+  int i,k;
+
+  fprintf(fp,"NMec = %d\n",problem->NMec);
+  fprintf(fp,"T = %d\n",problem->T);
+  fprintf(fp,"P = %d\n",problem->P);
+  fprintf(fp,"Profits%s ignored\n",(problem->I == 0) ? " not" : "");
+  fprintf(fp,"Valid tasks: %I64d\n",problem->valid_tasks);//isto esta certo mas se tiveres outro melhor que lld...
+  fprintf(fp,"Solution time = %.3e\n",problem->cpu_time);
+  fprintf(fp,"Task data\n");
+#define TASK  problem->task[i]
+  for(i = 0;i < problem->T;i++)
+    fprintf(fp,"  %3d %3d %5d %d\n",TASK.starting_date,TASK.ending_date,TASK.profit,TASK.best_assigned_to);
+#undef TASK
+
+  fprintf(fp,"Best profit: %d\n",problem->best_total_profit);
+  fprintf(fp,"Wall time = %.3e\n",problem->wall_time);
+  if(solvers[problem->solver].function == timeline_decomposition)
+    fprintf(fp,"Blocks: %d\n",problem->n_blocks);
+  if(solvers[problem->solver].function == reduced_enumeration)
+    fprintf(fp,"Groups: %d (%d dominated tasks dropped)\n",problem->n_groups,problem->n_dropped);
+  if(solvers[problem->solver].function == parallel_sampler)
+    fprintf(fp,"Samples: %lld (%s sampling, %d threads)\n",problem->n_drawn,
+            (problem->feasible_sampling != 0) ? "feasible" : "blind",problem->n_threads);
+  if(solvers[problem->solver].function == checkpointed_enumeration && problem->resumed != 0)
+    fprintf(fp,"Resumed from a checkpoint (the times are those of the last run only)\n");
+  if(solvers[problem->solver].function == local_search)
+  {
+    fprintf(fp,"Moves: %lld (%lld accepted)\n",problem->n_moves,problem->n_accepted);
+    fprintf(fp,"Improvements (time profit):\n");
+    for(i = 0;i < problem->n_improvements;i++)
+      fprintf(fp,"%.6f %d\n",problem->improvement_time[i],problem->improvement_profit[i]);
+  }
+  if(solvers[problem->solver].function == top_k_enumeration)
+  {
+    fprintf(fp,"Best %d subsets (profit, then the programmer of each task):\n",problem->n_top);
+    for(k = 0;k < problem->n_top;k++)
+    {
+      top_k_assignment(problem,k);
+      fprintf(fp,"%d",problem->top[k].profit);
+      for(i = 0;i < problem->T;i++)
+        fprintf(fp," %d",problem->task[i].assigned_to);
+      fprintf(fp,"\n");
+    }
+  }
+  if(solvers[problem->solver].function == run_branch_and_bound)
+  {
+    fprintf(fp,"Greedy profit: %d\n",problem->incumbent_profit);
+    fprintf(fp,"Visited nodes: %lld\n",problem->visited_nodes);
+    fprintf(fp,"Pruned nodes: %lld\n",problem->pruned_nodes);
+    if(problem->deadline > 0.0)
+    {
+      fprintf(fp,"Upper bound: %d\n",problem->upper_bound);
+      fprintf(fp,"Gap: %d (%.3f%%)\n",problem->upper_bound - problem->best_total_profit,
+              (problem->upper_bound > 0) ? 100.0 * (double)(problem->upper_bound - problem->best_total_profit) / (double)problem->upper_bound : 0.0);
+      fprintf(fp,"%s\n",(problem->stopped != 0) ? "Not proven optimal (deadline reached)" : "Proven optimal");
+    }
+  }
+  
+  if(problem->n_histogram > 0)
+  {
+    fprintf(fp,"All profits:\n");
+    for(i = 0;i < problem->n_histogram;i++)
+      fprintf(fp,"%d %lld\n",problem->histogram_profit[i],problem->histogram_count[i]);
+  }
+#ifdef SEARCH_STATS
+  if(problem->stats != NULL)
+    print_stats(problem->stats,fp);
+#endif
+  #if 0
+  fprintf(fp,"All profits:\n");
+  for(int i=0;i<=problem->sum_all_tasks;i++)
+    if(problem->valid_tasks_profits[i] != 0)
+        fprintf(fp,"%d %d\n",i,problem->valid_tasks_profits[i]);
+  #endif
+  
+  fprintf(fp,"End\n");
+  //
+  // terminate
+  //
+  if(fflush(fp) != 0 || ferror(fp) != 0 || fclose(fp) != 0)
+  {
+    fprintf(stderr,"Error while writing data to file %s\n",problem->file_name);
+    exit(1);
+  }
+}
+
+static void run_solver(problem_t *problem)
+{ // the solution data allocated by the solver is released by free_solution()
+  double (*cpu_clock)(void);
+
+  problem->valid_tasks_profits = NULL; // the solvers that build a histogram allocate it
+  problem->sum_all_tasks = 0;
+  problem->n_histogram = 0;
+  problem->histogram_profit = NULL;
+  problem->histogram_count = NULL;
+  problem->n_improvements = 0;
+  problem->improvement_time = NULL;
+  problem->improvement_profit = NULL;
+  problem->n_top = 0;
+  problem->top = NULL;
+#ifdef SEARCH_STATS
+  problem->stats = alloc_stats(problem->T);
+#endif
+  cpu_clock = (problem->batch == 0) ? cpu_time : thread_cpu_time; // in a batch sweep the other threads also run
+  problem->cpu_time = (*cpu_clock)();
+  problem->wall_time = wall_time();
+  // call your (recursive?) function to solve the problem here
+  (*solvers[problem->solver].function)(problem);
+  
+  problem->cpu_time = (*cpu_clock)() - problem->cpu_time;
+  problem->wall_time = wall_time() - problem->wall_time;
+#ifdef SEARCH_STATS
+  stats_switch_band(problem->stats,0);
+#endif
+}
+
+static void free_solution(problem_t *problem)
+{
+  free(problem->valid_tasks_profits);
+  free(problem->histogram_profit);
+  free(problem->histogram_count);
+  free(problem->improvement_time);
+  free(problem->improvement_profit);
+  free(problem->top);
+#ifdef SEARCH_STATS
+  free_stats(problem->stats);
+  problem->stats = NULL;
+#endif
+}
+
+static void solve(problem_t *problem)
+{
+  FILE *fp;
+
+  check_solver_limits(problem);
+  //
+  // open log file
+  //
+  fp = open_solution_file(problem);
+  //
+  // solve
+  //
+  run_solver(problem);
+  //
+  // save solution data
+  //
+  save_solution(problem,fp);
+  free_solution(problem);
+}
+
+#endif
+
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// batch sweep
+//
+// Solves, in one process, all instances (NMec,T,P) with NMec in a comma separated list, T and P in ranges (a..b or a
+// single number) and T >= P, as the do_it_* scripts do with one process per instance. The instances are solved by
+// -threads workers, one thread per instance, largest first (by T, then by P) so that a long instance is not left to
+// the end. The instances whose solution file already ends with "End" are skipped, and each solution file is written
+// (and reported in the standard output) as soon as its instance is solved. init_problem() uses the global state of the
+// random number generator, so it is called with the lock held. The solvers keep their state in the problem or in
+// memory allocated by each call, except random_approach(), whose rand() calls share one hidden state (its results
+// would depend on the scheduling of the workers), so it is rejected with more than one worker.
+//
+
+#define MAX_BATCH_NMEC  64
+
+typedef struct
+{
+  int NMec;
+  int T;
+  int P;
+}
+batch_job_t;
+
+typedef struct
+{
+  problem_t *model;         // solver and options of all instances
+  int I;
+  batch_job_t *job;
+  int n_jobs;
+  int next_job;             // protected by lock
+  int n_finished;           // protected by lock
+  pthread_mutex_t lock;
+}
+batch_t;
+
+static int compare_batch_jobs(const void *j1,const void *j2)
+{
+  const batch_job_t *a = (const batch_job_t *)j1;
+  const batch_job_t *b = (const batch_job_t *)j2;
+
+  if(a->T != b->T)
+    return (a->T > b->T) ? -1 : +1;
+  if(a->P != b->P)
+    return (a->P > b->P) ? -1 : +1;
+  if(a->NMec != b->NMec)
+    return (a->NMec < b->NMec) ? -1 : +1;
+  return 0;
+}
+
+static void parse_range(char *text,int *first,int *last)
+{
+  char c;
+
+  if(sscanf(text,"%d..%d%c",first,last,&c) != 2)
+  {
+    if(sscanf(text,"%d%c",first,&c) != 1)
+    {
+      fprintf(stderr,"Bad range %s (use a..b or a single number)\n",text);
+      exit(1);
+    }
+    *last = *first;
+  }
+  if(*first > *last)
+  {
+    fprintf(stderr,"Bad range %s (empty)\n",text);
+    exit(1);
+  }
+}
+
+static int solution_is_complete(char *file_name)
+{
+  char line[128],last_line[128];
+  FILE *fp;
+
+  fp = fopen(file_name,"r");
+  if(fp == NULL)
+    return 0;
+  last_line[0] = '\0';
+  while(fgets(line,sizeof(line),fp) != NULL)
+    strcpy(last_line,line);
+  fclose(fp);
+  return (strcmp(last_line,"End\n") == 0) ? 1 : 0;
+}
+
+static void *batch_worker(void *arg)
+{
+  batch_t *batch = (batch_t *)arg;
+  problem_t *problem;
+  int j,done;
+
+  problem = (problem_t *)malloc(sizeof(problem_t));
+  if(problem == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(;;)
+  {
+    pthread_mutex_lock(&batch->lock);
+    j = batch->next_job++;
+    if(j >= batch->n_jobs)
+    {
+      pthread_mutex_unlock(&batch->lock);
+      break;
+    }
+    *problem = *batch->model;
+    init_problem(batch->job[j].NMec,batch->job[j].T,batch->job[j].P,batch->I,problem);
+    pthread_mutex_unlock(&batch->lock);
+    done = solution_is_complete(problem->file_name);
+    if(done == 0)
+      solve(problem);
+    free_problem(problem);
+    pthread_mutex_lock(&batch->lock);
+    batch->n_finished++;
+    if(done != 0)
+      printf("[%d/%d] %s already done\n",batch->n_finished,batch->n_jobs,problem->file_name);
+    else
+      printf("[%d/%d] %s solved in %.3e s\n",batch->n_finished,batch->n_jobs,problem->file_name,problem->wall_time);
+    fflush(stdout);
+    pthread_mutex_unlock(&batch->lock);
+  }
+  free(problem);
+  return NULL;
+}
+
+static int parse_NMec_list(char *NMec_list,int *NMec)
+{ // NMec[] has room for MAX_BATCH_NMEC student numbers; returns how many were given
+  int n_NMec;
+  char *s,*end;
+
+  for(n_NMec = 0,s = NMec_list;;s = end + 1)
+  {
+    if(n_NMec == MAX_BATCH_NMEC)
+    {
+      fprintf(stderr,"Too many student numbers (at most %d)\n",MAX_BATCH_NMEC);
+      exit(1);
+    }
+    NMec[n_NMec++] = (int)strtol(s,&end,10);
+    if(end == s || (*end != ',' && *end != '\0'))
+    {
+      fprintf(stderr,"Bad list of student numbers %s (use n1,n2,...)\n",NMec_list);
+      exit(1);
+    }
+    if(*end == '\0')
+      break;
+  }
+  return n_NMec;
+}
+
+static void batch_sweep(char *NMec_list,char *T_range,char *P_range,int I,problem_t *model)
+{
+  int NMec[MAX_BATCH_NMEC],n_NMec,first_T,last_T,first_P,last_P,T,P,n,w,n_workers;
+  pthread_t *thread;
+  batch_t batch;
+
+  //
+  // instances
+  //
+  n_NMec = parse_NMec_list(NMec_list,NMec);
+  parse_range(T_range,&first_T,&last_T);
+  parse_range(P_range,&first_P,&last_P);
+  batch.job = (batch_job_t *)malloc((size_t)n_NMec * (size_t)(last_T - first_T + 1) * (size_t)(last_P - first_P + 1) * sizeof(batch_job_t));
+  if(batch.job == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  batch.n_jobs = 0;
+  for(n = 0;n < n_NMec;n++)
+    for(T = first_T;T <= last_T;T++)
+      for(P = first_P;P <= last_P && P <= T;P++)
+      {
+        batch.job[batch.n_jobs].NMec = NMec[n];
+        batch.job[batch.n_jobs].T = T;
+        batch.job[batch.n_jobs].P = P;
+        batch.n_jobs++;
+      }
+  qsort((void *)batch.job,(size_t)batch.n_jobs,sizeof(batch.job[0]),compare_batch_jobs);
+  //
+  // solve them
+  //
+  n_workers = (model->n_threads < batch.n_jobs) ? model->n_threads : batch.n_jobs;
+  if(n_workers > 1 && (solvers[model->solver].function == random_approach ||
+                       (solvers[model->solver].function == timeline_decomposition &&
+                        solvers[model->inner_solver].function == random_approach)))
+  {
+    fprintf(stderr,"The solver random_approach is not reentrant; use -threads 1 with -batch\n");
+    exit(1);
+  }
+  model->n_threads = 1;
+  model->batch = 1;
+  batch.model = model;
+  batch.I = I;
+  batch.next_job = 0;
+  batch.n_finished = 0;
+  pthread_mutex_init(&batch.lock,NULL);
+  thread = (pthread_t *)malloc((size_t)(n_workers + 1) * sizeof(pthread_t));
+  if(thread == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(w = 0;w < n_workers;w++)
+    if(pthread_create(&thread[w],NULL,batch_worker,&batch) != 0)
+    {
+      fprintf(stderr,"Unable to create thread %d\n",w);
+      exit(1);
+    }
+  for(w = 0;w < n_workers;w++)
+    pthread_join(thread[w],NULL);
+  pthread_mutex_destroy(&batch.lock);
+  free(thread);
+  free(batch.job);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// measure the execution time of all solvers
+//
+// Each solver solves each instance (NMec,T,P) of a grid (as in a batch sweep) MEASURE_RUNS + 2 * MEASURE_EXTRA times;
+// the MEASURE_EXTRA fastest and slowest runs are discarded (possible outliers) and the minimum, maximum, average and
+// standard deviation of the wall time of the remaining ones are reported, in one table per solver. The runs of an
+// instance stop after MEASURE_MAX_TIME seconds; in that case the runs made are not trimmed, and the larger values of
+// T of the same NMec and P are skipped. The branch-and-bound is given the time that remains (as a -deadline); if it
+// stops before proving the optimum, its best profit is not used and the larger values of T are skipped. As the runs
+// of the other solvers cannot be interrupted, the larger values of T are also skipped when the time of one run,
+// predicted from the previous ones (the average time of the last T times its growth from the T before it, or
+// MEASURE_GROWTH if that is not known yet), is over MEASURE_MAX_TIME, so that one exponential run does not take the
+// whole sweep. The instances a solver cannot handle are also skipped. At the end, the best profits found by the exact
+// solvers are compared.
+//
+
+#define MEASURE_RUNS        5     // number of measurements kept for each instance
+#define MEASURE_EXTRA       1     // number of measurements discarded on each side
+#define MEASURE_MAX_TIME  10.0    // maximum amount of time, in seconds, spent in an instance
+#define MEASURE_GROWTH     2.0    // growth of the time of a run from T to T+1 assumed when it is not known yet
+
+static int solver_is_exact(problem_t *model,int I,int S)
+{
+  if(solvers[S].function == timeline_decomposition)
+    S = model->inner_solver;
+  if(solvers[S].function == max_tasks)
+    return (I != 0) ? 1 : 0;
+  return solvers[S].exact;
+}
+
+static void measure_solvers(char *NMec_list,char *T_range,char *P_range,int I,problem_t *model)
+{
+  int NMec[MAX_BATCH_NMEC],n_NMec,first_T,last_T,first_P,last_P,n_T,n_P,T,P,n,S,S0,i,j,k,n_runs,skip,n_instances;
+  int n_disagreements,stopped,*best;
+  double t[MEASURE_RUNS + 2 * MEASURE_EXTRA],v,w,total,last_v,growth;
+  problem_t problem;
+
+  n_NMec = parse_NMec_list(NMec_list,NMec);
+  parse_range(T_range,&first_T,&last_T);
+  parse_range(P_range,&first_P,&last_P);
+  n_T = last_T - first_T + 1;
+  n_P = last_P - first_P + 1;
+  best = (int *)malloc((size_t)N_SOLVERS * (size_t)n_NMec * (size_t)n_T * (size_t)n_P * sizeof(int));
+  if(best == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+#define BEST(S,n,T,P)  best[(((size_t)(S) * (size_t)n_NMec + (size_t)(n)) * (size_t)n_T + (size_t)((T) - first_T)) *    \
+                            (size_t)n_P + (size_t)((P) - first_P)]
+  for(S = 0;S < N_SOLVERS;S++)
+  {
+    printf("# %s%s\n",solvers[S].name,(solver_is_exact(model,I,S) != 0) ? "" : " (not exact)");
+    printf("#   NMec   T  P runs  min time  max time  avg time   std dev best profit\n");
+    printf("#------- --- -- ---- --------- --------- --------- --------- -----------\n");
+    for(n = 0;n < n_NMec;n++)
+      for(P = first_P;P <= last_P;P++)
+        for(skip = 0,last_v = -1.0,growth = MEASURE_GROWTH,T = first_T;T <= last_T;T++)
+        {
+          BEST(S,n,T,P) = -1; // not solved
+          if(skip != 0 || P > T || T > solvers[S].max_T || P > solvers[S].max_P ||
+             (solvers[S].function == timeline_decomposition && (T > solvers[model->inner_solver].max_T ||
+                                                                 P > solvers[model->inner_solver].max_P)))
+            continue;
+          if(last_v > 0.0 && last_v * growth > MEASURE_MAX_TIME)
+          { // a single run would probably take too long; skip this and the larger values of T
+            printf("# %7d %3d %2d skipped (predicted time of one run %.3e s)\n",NMec[n],T,P,last_v * growth);
+            skip = 1;
+            continue;
+          }
+          total = 0.0;
+          stopped = 0;
+          for(n_runs = 0;n_runs < MEASURE_RUNS + 2 * MEASURE_EXTRA && total < MEASURE_MAX_TIME && stopped == 0;n_runs++)
+          {
+            problem = *model;
+            problem.solver = S;
+            init_problem(NMec[n],T,P,I,&problem);
+            if(solvers[S].function == run_branch_and_bound &&
+               (problem.deadline <= 0.0 || problem.deadline > MEASURE_MAX_TIME - total))
+              problem.deadline = MEASURE_MAX_TIME - total; // the time that remains for this instance
+            run_solver(&problem);
+            if(solvers[S].function == run_branch_and_bound && problem.stopped != 0)
+              stopped = 1;
+            if(stopped != 0)
+              BEST(S,n,T,P) = -1; // optimum not proven
+            else if(n_runs == 0)
+              BEST(S,n,T,P) = problem.best_total_profit;
+            else if(problem.best_total_profit != BEST(S,n,T,P) && solver_is_exact(model,I,S) != 0)
+              fprintf(stderr,"%s: different best profits in two runs of NMec=%d T=%d P=%d\n",solvers[S].name,
+                      NMec[n],T,P);
+            free_solution(&problem);
+            free_problem(&problem);
+            v = problem.wall_time;
+            total += v;
+            // insertion sort!
+            for(j = n_runs;j > 0 && t[j - 1] > v;j--)
+              t[j] = t[j - 1];
+            t[j] = v;
+          }
+          if(n_runs == MEASURE_RUNS + 2 * MEASURE_EXTRA)
+          {
+            i = MEASURE_EXTRA;
+            k = MEASURE_RUNS;
+          }
+          else
+          { // too much time spent on this instance; skip the larger values of T
+            i = 0;
+            k = n_runs;
+            skip = 1;
+          }
+          v = 0.0;
+          for(j = i;j < i + k;j++)
+            v += t[j];
+          v /= (double)k;
+          w = 0.0;
+          for(j = i;j < i + k;j++)
+            w += (t[j] - v) * (t[j] - v);
+          w /= (double)k;
+          printf("%8d %3d %2d %4d %.3e %.3e %.3e %.3e %11d\n",NMec[n],T,P,k,t[i],t[i + k - 1],v,sqrt(w),
+                 BEST(S,n,T,P));
+          fflush(stdout);
+          growth = (last_v > 0.0 && v > last_v) ? v / last_v : (last_v > 0.0) ? 1.0 : MEASURE_GROWTH;
+          last_v = v;
+        }
+    printf("#------- --- -- ---- --------- --------- --------- --------- -----------\n");
+    printf("\n\n");
+    fflush(stdout);
+  }
+  //
+  // do the exact solvers agree?
+  //
+  n_instances = n_disagreements = 0;
+  for(n = 0;n < n_NMec;n++)
+    for(T = first_T;T <= last_T;T++)
+      for(P = first_P;P <= last_P && P <= T;P++)
+      {
+        for(S0 = 0;S0 < N_SOLVERS && (solver_is_exact(model,I,S0) == 0 || BEST(S0,n,T,P) < 0);S0++)
+          ;
+        if(S0 == N_SOLVERS)
+          continue; // not solved by any exact solver
+        n_instances++;
+        for(S = S0 + 1;S < N_SOLVERS;S++)
+          if(solver_is_exact(model,I,S) != 0 && BEST(S,n,T,P) >= 0 && BEST(S,n,T,P) != BEST(S0,n,T,P))
+          {
+            printf("# disagreement for NMec=%d T=%d P=%d: %s found %d, %s found %d\n",NMec[n],T,P,
+                   solvers[S0].name,BEST(S0,n,T,P),solvers[S].name,BEST(S,n,T,P));
+            n_disagreements++;
+          }
+      }
+#undef BEST
+  if(n_disagreements == 0)
+    printf("# the exact solvers agree on the best profit of all %d instances they solved\n",n_instances);
+  else
+    printf("# %d disagreements between the exact solvers (%d instances)\n",n_disagreements,n_instances);
+  free(best);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// incremental re-solve
+//
+// An incremental_t keeps an optimal flow of the min-cost flow network (see min_cost_flow()) of a set of tasks that
+// changes, so that each change costs one shortest path computation instead of a full solution. The network has a
+// source node (date INT_MIN) and a sink node (date INT_MAX); the nodes of the dates are inserted, in date order, between
+// them when needed, by splitting the idle arc that joins the two nodes around the new one (the idle arcs have
+// unlimited capacity, so the P units of flow sent from the source to the sink are the programmers). The residual network
+// of an optimal flow has no negative cycles, so there are node potentials that make all reduced costs non-negative,
+// and the shortest paths are found with Dijkstra's algorithm, stopped as soon as the destination is reached. Only the
+// differences between potentials matter, so instead of increasing the potentials of the nodes that were not reached
+// by the distance of the destination, those of the nodes reached are decreased; the cost of a search is proportional
+// to the number of nodes it visits, not to the size of the network. Then:
+// * a new task either gets no flow, or the unit of flow of the most negative cycle through its arc (the task arc plus the
+//   shortest path from its ending node back to its starting node, if that is negative);
+// * a task that is removed with a unit of flow has that unit rerouted from its starting node to its ending node along
+//   a shortest path;
+// * increasing (decreasing) P by one sends one unit of flow along a shortest path from the source to the sink (from the
+//   sink to the source).
+// Each one of these changes keeps the flow optimal. The programmer of each task done is found by following the P
+// units of flow from the source to the sink (incremental_assignment()).
+//
+
+#define INCREMENTAL_INFINITY  (INT_MAX / 2)  // capacity of the idle arcs
+
+typedef struct
+{
+  int P;                  // number of programmers (units of flow sent from the source to the sink)
+  long long cost;         // cost of the flow (minus the best total profit)
+  int n_nodes;            // node 0 is the source and node 1 is the sink
+  int max_nodes;
+  int *date;              // date of each node
+  int *first;             // first arc leaving each node
+  int *idle_arc;          // arc to the next node in date order (-1 for the sink)
+  int *order;             // the nodes sorted by date
+  long long *potential;   // potential of each node
+  long long *dist;        // shortest path work arrays (dist[] is LLONG_MAX between searches)
+  int *parent_arc;
+  int *touched;           // nodes with a finite dist[]
+  int heap_size;
+  int *heap_node;         // binary heap (lazy deletion, so it can have as many entries as arcs)
+  long long *heap_dist;
+  int n_arcs;             // arc k ^ 1 is the reverse of arc k
+  int max_arcs;
+  arc_t *arc;
+  int *arc_task;          // task of the arcs 2k and 2k+1 (-1 for an idle arc)
+  int n_tasks;            // removed tasks keep their number
+  int max_tasks;
+  task_t *task;           // the assigned_to field holds the arc of the task (-1 if it was removed)
+}
+incremental_t;
+
+static void *grow_array(void *p,size_t size)
+{
+  p = realloc(p,size);
+  if(p == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  return p;
+}
+
+static int incremental_add_arc(incremental_t *inc,int from,int to,int capacity,long long cost,int task)
+{ // adds the arc and its reverse (with no flow); returns the arc
+  int k = inc->n_arcs;
+
+  if(k + 2 > inc->max_arcs)
+  {
+    inc->max_arcs = 2 * inc->max_arcs + 16;
+    inc->arc = (arc_t *)grow_array(inc->arc,(size_t)inc->max_arcs * sizeof(arc_t));
+    inc->arc_task = (int *)grow_array(inc->arc_task,(size_t)(inc->max_arcs / 2) * sizeof(int));
+    inc->heap_node = (int *)grow_array(inc->heap_node,(size_t)(inc->max_arcs + 2) * sizeof(int));
+    inc->heap_dist = (long long *)grow_array(inc->heap_dist,(size_t)(inc->max_arcs + 2) * sizeof(long long));
+  }
+  inc->arc[k].to = to;
+  inc->arc[k].capacity = capacity;
+  inc->arc[k].cost = cost;
+  inc->arc[k].next = inc->first[from];
+  inc->first[from] = k;
+  inc->arc[k + 1].to = from;
+  inc->arc[k + 1].capacity = 0;
+  inc->arc[k + 1].cost = -cost;
+  inc->arc[k + 1].next = inc->first[to];
+  inc->first[to] = k + 1;
+  inc->arc_task[k / 2] = task;
+  inc->n_arcs += 2;
+  return k;
+}
+
+static int incremental_new_node(incremental_t *inc,int date)
+{
+  int u = inc->n_nodes++;
+
+  if(inc->n_nodes > inc->max_nodes)
+  {
+    inc->max_nodes = 2 * inc->max_nodes + 16;
+    inc->date = (int *)grow_array(inc->date,(size_t)inc->max_nodes * sizeof(int));
+    inc->first = (int *)grow_array(inc->first,(size_t)inc->max_nodes * sizeof(int));
+    inc->idle_arc = (int *)grow_array(inc->idle_arc,(size_t)inc->max_nodes * sizeof(int));
+    inc->order = (int *)grow_array(inc->order,(size_t)inc->max_nodes * sizeof(int));
+    inc->potential = (long long *)grow_array(inc->potential,(size_t)inc->max_nodes * sizeof(long long));
+    inc->dist = (long long *)grow_array(inc->dist,(size_t)inc->max_nodes * sizeof(long long));
+    inc->parent_arc = (int *)grow_array(inc->parent_arc,(size_t)inc->max_nodes * sizeof(int));
+    inc->touched = (int *)grow_array(inc->touched,(size_t)inc->max_nodes * sizeof(int));
+  }
+  inc->date[u] = date;
+  inc->first[u] = -1;
+  inc->idle_arc[u] = -1;
+  inc->potential[u] = 0;
+  inc->dist[u] = LLONG_MAX;
+  return u;
+}
+
+static void incremental_init(incremental_t *inc,int P)
+{
+  memset(inc,0,sizeof(*inc));
+  (void)incremental_new_node(inc,INT_MIN);
+  (void)incremental_new_node(inc,INT_MAX);
+  inc->order[0] = 0;
+  inc->order[1] = 1;
+  inc->idle_arc[0] = incremental_add_arc(inc,0,1,INCREMENTAL_INFINITY - P,0LL,-1);
+  inc->arc[inc->idle_arc[0] + 1].capacity = P;
+  inc->P = P;
+  inc->cost = 0;
+}
+
+static void incremental_free(incremental_t *inc)
+{
+  free(inc->date);
+  free(inc->first);
+  free(inc->idle_arc);
+  free(inc->order);
+  free(inc->potential);
+  free(inc->dist);
+  free(inc->parent_arc);
+  free(inc->touched);
+  free(inc->heap_node);
+  free(inc->heap_dist);
+  free(inc->arc);
+  free(inc->arc_task);
+  free(inc->task);
+}
+
+static int incremental_node(incremental_t *inc,int date)
+{ // the node of the date (created, if necessary, by splitting the idle arc a->b of its neighbors into a->m and m->b)
+  int lo = 0,hi = inc->n_nodes - 1,mid,a,b,m,k,*link;
+
+  while(lo < hi)
+  { // the sink has the largest date, so this finds the first node with a date not smaller than date
+    mid = (lo + hi) / 2;
+    if(inc->date[inc->order[mid]] < date)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if(inc->date[inc->order[lo]] == date)
+    return inc->order[lo];
+  a = inc->order[lo - 1];
+  b = inc->order[lo];
+  m = incremental_new_node(inc,date);
+  memmove(&inc->order[lo + 1],&inc->order[lo],(size_t)(inc->n_nodes - 1 - lo) * sizeof(int));
+  inc->order[lo] = m;
+  k = inc->idle_arc[a];
+  inc->arc[k].to = m;                                                 // a->b becomes a->m
+  for(link = &inc->first[b];*link != (k ^ 1);link = &inc->arc[*link].next)
+    ;
+  *link = inc->arc[k ^ 1].next;                                       // move b->a (its reverse) to the list of m
+  inc->arc[k ^ 1].next = inc->first[m];
+  inc->first[m] = k ^ 1;
+  inc->idle_arc[m] = incremental_add_arc(inc,m,b,inc->arc[k].capacity,0LL,-1);
+  inc->arc[inc->idle_arc[m] + 1].capacity = inc->arc[k ^ 1].capacity; // same flow
+  inc->potential[m] = inc->potential[a]; // a->b had a non-negative reduced cost (zero if it had flow)
+  return m;
+}
+
+static void incremental_heap_push(incremental_t *inc,int node,long long key)
+{
+  int i;
+
+  for(i = ++inc->heap_size;i > 1 && inc->heap_dist[i / 2] > key;i /= 2)
+  {
+    inc->heap_node[i] = inc->heap_node[i / 2];
+    inc->heap_dist[i] = inc->heap_dist[i / 2];
+  }
+  inc->heap_node[i] = node;
+  inc->heap_dist[i] = key;
+}
+
+static int incremental_heap_pop(incremental_t *inc,long long *key)
+{ // returns the node with the smallest key
+  int i,k,node;
+
+  node = inc->heap_node[1];
+  *key = inc->heap_dist[1];
+  for(i = 1;2 * i < inc->heap_size;i = k)
+  {
+    k = (2 * i + 1 < inc->heap_size && inc->heap_dist[2 * i + 1] < inc->heap_dist[2 * i]) ? 2 * i + 1 : 2 * i;
+    if(inc->heap_dist[k] >= inc->heap_dist[inc->heap_size])
+      break;
+    inc->heap_node[i] = inc->heap_node[k];
+    inc->heap_dist[i] = inc->heap_dist[k];
+  }
+  inc->heap_node[i] = inc->heap_node[inc->heap_size];
+  inc->heap_dist[i] = inc->heap_dist[inc->heap_size--];
+  return node;
+}
+
+static int incremental_shortest_path(incremental_t *inc,int from,int to,long long min_shift,long long *cost)
+{ // returns 0 if there is no path; otherwise, its cost is stored in *cost and the path is given by parent_arc[]
+  int u,v,k,n_touched,reached;
+  long long d,shift;
+
+  inc->heap_size = 0;
+  inc->dist[from] = 0;
+  inc->touched[0] = from;
+  n_touched = 1;
+  incremental_heap_push(inc,from,0LL);
+  reached = 0;
+  while(inc->heap_size > 0)
+  {
+    u = incremental_heap_pop(inc,&d);
+    if(d > inc->dist[u])
+      continue; // stale entry
+    if(u == to)
+    {
+      reached = 1;
+      break;
+    }
+    for(k = inc->first[u];k >= 0;k = inc->arc[k].next)
+      if(inc->arc[k].capacity > 0)
+      {
+        v = inc->arc[k].to;
+        d = inc->dist[u] + inc->arc[k].cost + inc->potential[u] - inc->potential[v]; // reduced cost (not negative)
+        if(d < inc->dist[v])
+        {
+          if(inc->dist[v] == LLONG_MAX)
+            inc->touched[n_touched++] = v;
+          inc->dist[v] = d;
+          inc->parent_arc[v] = k;
+          incremental_heap_push(inc,v,d);
+        }
+      }
+  }
+  //
+  // update the potentials: the nodes at a distance smaller than shift get dist[] - shift, all others are unchanged
+  // (shift is the distance of the destination or, if it was not reached, at least min_shift and at least the distance
+  // of all nodes reached)
+  //
+  if(reached != 0)
+  {
+    shift = inc->dist[to];
+    *cost = inc->dist[to] - inc->potential[from] + inc->potential[to];
+  }
+  else
+    for(shift = min_shift,k = 0;k < n_touched;k++)
+      if(inc->dist[inc->touched[k]] > shift)
+        shift = inc->dist[inc->touched[k]];
+  for(k = 0;k < n_touched;k++)
+  {
+    u = inc->touched[k];
+    if(inc->dist[u] < shift)
+      inc->potential[u] += inc->dist[u] - shift;
+    inc->dist[u] = LLONG_MAX;
+  }
+  return reached;
+}
+
+static void incremental_push(incremental_t *inc,int from,int to)
+{ // one unit of flow along the path found by incremental_shortest_path()
+  int v,k;
+
+  for(v = to;v != from;v = inc->arc[k ^ 1].to)
+  {
+    k = inc->parent_arc[v];
+    inc->arc[k].capacity--;
+    inc->arc[k ^ 1].capacity++;
+    inc->cost += inc->arc[k].cost;
+  }
+}
+
+static int incremental_add_task(incremental_t *inc,int starting_date,int ending_date,int profit)
+{ // returns the task number
+  int t,u,v,k;
+  long long d;
+
+  if(inc->n_tasks == inc->max_tasks)
+  {
+    inc->max_tasks = 2 * inc->max_tasks + 16;
+    inc->task = (task_t *)grow_array(inc->task,(size_t)inc->max_tasks * sizeof(task_t));
+  }
+  t = inc->n_tasks++;
+  inc->task[t].starting_date = starting_date;
+  inc->task[t].ending_date = ending_date;
+  inc->task[t].profit = profit;
+  u = incremental_node(inc,starting_date);
+  v = incremental_node(inc,ending_date + 1);
+  k = incremental_add_arc(inc,u,v,0,-(long long)profit,t); // no capacity during the search for a negative cycle
+  inc->task[t].assigned_to = k;
+  if(incremental_shortest_path(inc,v,u,(long long)profit + inc->potential[v] - inc->potential[u],&d) != 0 &&
+     d - (long long)profit < 0LL)
+  { // the task is done
+    incremental_push(inc,v,u);
+    inc->arc[k + 1].capacity = 1;
+    inc->cost -= (long long)profit;
+  }
+  else
+    inc->arc[k].capacity = 1;
+  return t;
+}
+
+static int incremental_remove_task(incremental_t *inc,int t)
+{ // returns 0 if there is no such task
+  int k;
+  long long d;
+
+  if(t < 0 || t >= inc->n_tasks || inc->task[t].assigned_to < 0)
+    return 0;
+  k = inc->task[t].assigned_to;
+  inc->task[t].assigned_to = -1;
+  inc->arc[k].capacity = 0;
+  if(inc->arc[k + 1].capacity != 0)
+  { // the task was done; its unit of flow is rerouted (there is always a path, made of idle arcs)
+    inc->arc[k + 1].capacity = 0;
+    inc->cost -= inc->arc[k].cost;
+    (void)incremental_shortest_path(inc,inc->arc[k + 1].to,inc->arc[k].to,0LL,&d);
+    incremental_push(inc,inc->arc[k + 1].to,inc->arc[k].to);
+  }
+  return 1;
+}
+
+static void incremental_set_P(incremental_t *inc,int P)
+{
+  long long d;
+
+  for(;inc->P < P;inc->P++)
+  {
+    (void)incremental_shortest_path(inc,0,1,0LL,&d);
+    incremental_push(inc,0,1);
+  }
+  for(;inc->P > P;inc->P--)
+  {
+    (void)incremental_shortest_path(inc,1,0,0LL,&d);
+    incremental_push(inc,1,0);
+  }
+}
+
+static int incremental_add_tasks(incremental_t *inc,int n,const task_t *task)
+{ // adds n tasks at once, as min_cost_flow() would solve them (for many tasks this is much faster than adding them one
+  // at a time); returns the number of the first one
+  int t,i,u,k,P;
+
+  P = inc->P;
+  incremental_set_P(inc,0);
+  for(i = 0;i < n;i++)
+  {
+    if(inc->n_tasks == inc->max_tasks)
+    {
+      inc->max_tasks = 2 * inc->max_tasks + 16;
+      inc->task = (task_t *)grow_array(inc->task,(size_t)inc->max_tasks * sizeof(task_t));
+    }
+    t = inc->n_tasks++;
+    inc->task[t] = task[i];
+    inc->task[t].assigned_to = incremental_add_arc(inc,incremental_node(inc,task[i].starting_date),
+                                                   incremental_node(inc,task[i].ending_date + 1),1,
+                                                   -(long long)task[i].profit,t);
+  }
+  //
+  // with no flow all arcs go forward in time, so the potentials are the distances from the source (nodes in date
+  // order)
+  //
+  for(u = 1;u < inc->n_nodes;u++)
+    inc->potential[u] = LLONG_MAX;
+  inc->potential[0] = 0;
+  for(i = 0;i < inc->n_nodes;i++)
+    if(inc->potential[u = inc->order[i]] < LLONG_MAX)
+      for(k = inc->first[u];k >= 0;k = inc->arc[k].next)
+        if(inc->arc[k].capacity > 0 && inc->potential[u] + inc->arc[k].cost < inc->potential[inc->arc[k].to])
+          inc->potential[inc->arc[k].to] = inc->potential[u] + inc->arc[k].cost;
+  incremental_set_P(inc,P);
+  return inc->n_tasks - n;
+}
+
+static int incremental_assignment(incremental_t *inc,int *programmer)
+{ // programmer[t] is the programmer of task t (-1 if it is not done); returns the number of tasks done
+  int t,j,u,k,n_done,*flow;
+
+  flow = (int *)malloc((size_t)(inc->n_arcs / 2 + 1) * sizeof(int));
+  if(flow == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  for(k = 0;k < inc->n_arcs;k += 2)
+    flow[k / 2] = inc->arc[k + 1].capacity;
+  for(t = 0;t < inc->n_tasks;t++)
+    programmer[t] = -1;
+  n_done = 0;
+  for(j = 0;j < inc->P;j++)
+    for(u = 0;u != 1;u = inc->arc[k].to)
+    { // all arcs go forward in time, so each unit of flow reaches the sink
+      for(k = inc->first[u];k >= 0 && ((k & 1) != 0 || flow[k / 2] == 0);k = inc->arc[k].next)
+        ;
+      flow[k / 2]--;
+      if(inc->arc_task[k / 2] >= 0)
+      {
+        programmer[inc->arc_task[k / 2]] = j;
+        n_done++;
+      }
+    }
+  free(flow);
+  return n_done;
+}
+
+static long long incremental_check(incremental_t *inc)
+{ // the best profit of the current tasks, computed from scratch by min_cost_flow()
+  problem_t problem;
+  int t,n;
+
+  memset(&problem,0,sizeof(problem));
+  for(t = n = 0;t < inc->n_tasks;t++)
+    n += (inc->task[t].assigned_to >= 0) ? 1 : 0;
+  if(n == 0 || inc->P == 0)
+    return 0LL;
+  alloc_problem(&problem,n,inc->P);
+  problem.T = n;
+  problem.P = inc->P;
+  for(t = n = 0;t < inc->n_tasks;t++)
+    if(inc->task[t].assigned_to >= 0)
+      problem.task[n++] = inc->task[t];
+  qsort((void *)problem.task,(size_t)n,sizeof(problem.task[0]),compare_tasks); // as init_problem() does
+  min_cost_flow(&problem);
+  free_problem(&problem);
+  return (long long)problem.best_total_profit;
+}
+
+//
+// incremental re-solve driver: one request per line of the standard input, one response per request (a line that
+// starts with "ok" or with "error", and whose last field is the time, in seconds, used by the request)
+//   P n              set the number of programmers      ok best_profit time
+//   add s e p        add a task (dates s..e, profit p)   ok task best_profit time
+//   remove task      remove a task                      ok best_profit time
+//   load NMec T I    add the tasks of init_problem()    ok first_task best_profit time
+//   profit           best profit                        ok best_profit time
+//   solution         the assignment                     ok n_done time, followed by n_done lines "task programmer"
+//   check            compare with min_cost_flow()        ok best_profit time (error if they differ)
+// Empty lines and lines that start with # are ignored. At the end, the number of requests and the total and average
+// times are written to stderr.
+//
+
+static void incremental_driver(FILE *fp,int P)
+{
+  incremental_t inc;
+  problem_t problem;
+  char line[256],command[16],c;
+  int a,b,d,n,t,n_requests,*programmer;
+  long long check;
+  double time,total_time;
+
+  incremental_init(&inc,P);
+  n_requests = 0;
+  total_time = 0.0;
+  while(fgets(line,sizeof(line),fp) != NULL)
+  {
+    if(sscanf(line," %15s",command) != 1 || command[0] == '#')
+      continue;
+    n_requests++;
+    time = wall_time();
+    if(strcmp(command,"P") == 0 && sscanf(line," %*s %d %c",&a,&c) == 1 && a >= 0 && a <= MAX_P)
+    {
+      incremental_set_P(&inc,a);
+      printf("ok %lld",-inc.cost);
+    }
+    else if(strcmp(command,"add") == 0 && sscanf(line," %*s %d %d %d %c",&a,&b,&d,&c) == 3 && a <= b && d >= 0 &&
+            a > INT_MIN && b < INT_MAX - 1)
+    {
+      t = incremental_add_task(&inc,a,b,d);
+      printf("ok %d %lld",t,-inc.cost);
+    }
+    else if(strcmp(command,"remove") == 0 && sscanf(line," %*s %d %c",&a,&c) == 1 && incremental_remove_task(&inc,a) != 0)
+      printf("ok %lld",-inc.cost);
+    else if(strcmp(command,"load") == 0 && sscanf(line," %*s %d %d %d %c",&a,&b,&d,&c) == 3 && inc.P >= 1 && b >= 1 &&
+            b <= MAX_T && inc.P <= MAX_P)
+    {
+      memset(&problem,0,sizeof(problem));
+      init_problem(a,b,inc.P,d,&problem);
+      t = incremental_add_tasks(&inc,problem.T,problem.task);
+      free_problem(&problem);
+      printf("ok %d %lld",t,-inc.cost);
+    }
+    else if(strcmp(command,"profit") == 0)
+      printf("ok %lld",-inc.cost);
+    else if(strcmp(command,"solution") == 0)
+    {
+      programmer = (int *)malloc((size_t)(inc.n_tasks + 1) * sizeof(int));
+      if(programmer == NULL)
+      {
+        fprintf(stderr,"Strange! Unable to allocate memory\n");
+        exit(1);
+      }
+      n = incremental_assignment(&inc,programmer);
+      printf("ok %d %.3e\n",n,wall_time() - time);
+      for(t = 0;t < inc.n_tasks;t++)
+        if(programmer[t] >= 0)
+          printf("%d %d\n",t,programmer[t]);
+      free(programmer);
+      total_time += wall_time() - time;
+      fflush(stdout);
+      continue;
+    }
+    else if(strcmp(command,"check") == 0)
+    {
+      check = incremental_check(&inc);
+      if(check == -inc.cost)
+        printf("ok %lld",check);
+      else
+        printf("error incremental %lld, min_cost_flow %lld",-inc.cost,check);
+    }
+    else
+      printf("error bad request");
+    time = wall_time() - time;
+    total_time += time;
+    printf(" %.3e\n",time);
+    fflush(stdout);
+  }
+  fprintf(stderr,"%d requests in %.3e seconds (%.3e seconds per request)\n",n_requests,total_time,
+          (n_requests > 0) ? total_time / (double)n_requests : 0.0);
+  incremental_free(&inc);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// instance files
+//
+// An instance file has a header (instance_header_t) followed by T records that are task_t structures (assigned_to and
+// best_assigned_to are -1), sorted as init_problem() sorts the tasks, in the byte order of the machine that wrote it.
+// -load maps the file in memory (privately) and uses the records as the task[] array of the problem: nothing is
+// parsed or copied, and a page of the file is only copied if a solver changes it (on Windows, where there is no
+// mmap(), the records are read into allocated memory instead). On load the header and each task
+// are checked (dates >= 0, profits >= 0), the tasks are sorted if they are not, and the profit of any solution must
+// fit in an int (checked with the sum of all profits or, if it does not, with P times the best profit of a single
+// programmer). Finally, the dates are replaced by their ranks among all dates (starting and ending dates of all
+// tasks, each distinct date counted once), so they are in 0..2T-1 whatever the span of the file: no comparison of two
+// dates changes (so neither do the solutions), and the solvers that index arrays by date (the greedy solution of
+// the branch-and-bound, the local search) do not depend on how sparse the dates of a task log are. The solution file
+// of a loaded instance lists these ranks (its tasks are in the order of the file). Files are made by
+// * -generate, which writes a random instance of any size with the distribution of init_problem(), and by
+// * -import, which converts a CSV file (one "starting_date,ending_date,profit" line per task) to an instance file.
+//
+// The generator does not keep the tasks in memory. With D = total_span, w[k] the weight of a span k and W the sum
+// of the weights, a task with span k starts on each one of the dates 0,1,...,D-k with probability w[k]/(W*(D-k+1)),
+// so, with C[k] the sum of w[j]/(D-j+1) for j = 0,1,...,k,
+// * the probability that a task starts on date s is C[D-s]/W, and
+// * given that it starts on date s, its span is k (k <= D-s) with probability proportional to w[k]/(D-k+1).
+// The starting dates are the order statistics of T samples of the first distribution; they are generated in
+// increasing order (the largest of n uniform deviates is distributed as U^(1/n), and the other n-1 are uniform below
+// it), by walking the cumulative distribution of the dates. The span of each task is found by a binary search of
+// C[0..D-s], and the tasks that start on the same date are kept sorted by their ending dates. Time O(T log D + D),
+// memory O(D).
+//
+// The weights are those described in init_problem(). init_problem() itself favours the shorter spans a little when
+// total_span is large (its 30-bit random numbers are reduced modulo the sum of the weights, about 1100*total_span,
+// which does not even fit in an int at the sizes this generator is meant for); that bias is not reproduced. The
+// instances are not those of init_problem() (another random number generator is used), so each one is identified by
+// its NMec, T and P.
+//
+
+#define INSTANCE_MAGIC  "JSTASKS1"  // 8 bytes, not terminated
+
+typedef struct
+{
+  char magic[8];          // INSTANCE_MAGIC
+  int NMec;
+  int T;                  // number of tasks (records)
+  int P;                  // number of programmers (the dates of -generate are in 0..total_span, which depends on P)
+  int I;                  // if 1, all profits are 1
+  int total_span;         // largest date
+  int reserved;           // 0 (the records start at a multiple of 8 bytes)
+}
+instance_header_t;
+
+static void generate_instance(int NMec,int T,int P,int I,const char *file_name)
+{
+  int D,k,lo,hi,n,s,r,n_group,max_group,i;
+  double scale,w,W,F,log_max,y,target,t,*C;
+  instance_header_t header;
+  task_t task,*group;
+  stream_t stream;
+  FILE *fp;
+
+  if(NMec < 1 || NMec > 999999 || T < 1 || T > FILE_MAX_T || P < 1 || P > MAX_P)
+  {
+    fprintf(stderr,"Bad instance (1 <= NMec (%d) <= 999999, 1 <= T (%d) <= %d, 1 <= P (%d) <= %d)\n",NMec,T,
+            FILE_MAX_T,P,MAX_P);
+    exit(1);
+  }
+  D = (int)((10LL * (long long)T + (long long)P - 1LL) / (long long)P); // as in init_problem()
+  if(D < 30)
+    D = 30;
+  if(I == 0 && 301.0 * (double)D >= (double)INT_MAX)
+  {
+    fprintf(stderr,"The profits (up to about 300*%d) would not fit in an int (ignore them, or use more programmers)\n",D);
+    exit(1);
+  }
+  t = wall_time();
+  max_group = 16;
+  C = (double *)malloc((size_t)(D + 1) * sizeof(double));
+  group = (task_t *)malloc((size_t)max_group * sizeof(task_t));
+  if(C == NULL || group == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  //
+  // the weights of the spans of init_problem() (in floating point, they do not fit in an int for large D)
+  //
+  scale = ceil(100.0 * 10.0 * (double)(D - 29) / 298.0);
+  if(scale < 100.0)
+    scale = 100.0;
+  W = 0.0;
+  for(k = 0;k <= D;k++)
+  {
+    w = (k < 2) ? 0.0 : (k <= 10) ? scale * (double)(2 * k) : (k <= 29) ? scale * (double)(30 - k) : 100.0;
+    W += w;
+    C[k] = ((k > 0) ? C[k - 1] : 0.0) + w / (double)(D - k + 1);
+  }
+  //
+  // header
+  //
+  fp = fopen(file_name,"wb");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"Unable to create file %s\n",file_name);
+    exit(1);
+  }
+  memset(&header,0,sizeof(header));
+  memcpy(header.magic,INSTANCE_MAGIC,sizeof(header.magic));
+  header.NMec = NMec;
+  header.T = T;
+  header.P = P;
+  header.I = (I == 0) ? 0 : 1;
+  header.total_span = D;
+  (void)fwrite(&header,sizeof(header),(size_t)1,fp);
+  //
+  // the tasks (F is the probability that a task starts on a date <= s; the dates D-1 and D have probability 0)
+  //
+#define UNIFORM()  ((double)(stream_next(&stream) >> 11) * 0x1.0p-53)  // in [0,1)
+  stream_start(&stream,(uint64_t)NMec,(uint64_t)T);
+  log_max = 0.0;
+  s = 0;
+  F = C[D] / W;
+  n_group = 0;
+  for(n = T;n >= 1;n--)
+  {
+    log_max += log(1.0 - UNIFORM()) / (double)n;
+    y = -expm1(log_max); // the next smallest of the T uniform deviates
+    while(y >= F && s < D - 2)
+    { // next date
+      (void)fwrite(group,sizeof(group[0]),(size_t)n_group,fp);
+      n_group = 0;
+      s++;
+      F += C[D - s] / W;
+    }
+    target = UNIFORM() * C[D - s];
+    for(lo = 2,hi = D - s;lo < hi;)
+      if(C[(lo + hi) / 2] > target)
+        hi = (lo + hi) / 2;
+      else
+        lo = (lo + hi) / 2 + 1;
+    task.starting_date = s;
+    task.ending_date = s + lo - 1;
+    r = (int)(stream_next(&stream) % 12501ull); // the profit, as in init_problem()
+    if(r <= 2500)
+      task.profit = 1 + (int)round((double)lo * (50.0 + sqrt((double)r)));
+    else
+      task.profit = 1 + (int)round((double)lo * (300.0 - 2.0 * sqrt((double)(12500 - r))));
+    if(header.I != 0)
+      task.profit = 1;
+    task.assigned_to = -1;
+    task.best_assigned_to = -1;
+    if(n_group == max_group)
+    {
+      max_group *= 2;
+      group = (task_t *)realloc(group,(size_t)max_group * sizeof(task_t));
+      if(group == NULL)
+      {
+        fprintf(stderr,"Strange! Unable to allocate memory\n");
+        exit(1);
+      }
+    }
+    for(i = n_group++;i > 0 && group[i - 1].ending_date > task.ending_date;i--)
+      group[i] = group[i - 1];
+    group[i] = task;
+  }
+#undef UNIFORM
+  (void)fwrite(group,sizeof(group[0]),(size_t)n_group,fp);
+  if(fflush(fp) != 0 || ferror(fp) != 0 || fclose(fp) != 0)
+  {
+    fprintf(stderr,"Error while writing data to file %s\n",file_name);
+    exit(1);
+  }
+  printf("%s: NMec=%d T=%d P=%d I=%d, dates 0..%d, %.3f seconds\n",file_name,NMec,T,P,header.I,D,wall_time() - t);
+  free(C);
+  free(group);
+}
+
+static void import_csv(const char *csv_name,int NMec,int P)
+{
+  char line[1024],*bin_name,*p,*q;
+  int n_lines,header_line,max_tasks,sorted,k;
+  instance_header_t header;
+  long long v[3];
+  task_t *task;
+  double t;
+  FILE *fp;
+
+  if(NMec < 1 || NMec > 999999 || P < 1 || P > MAX_P)
+  {
+    fprintf(stderr,"Bad instance (1 <= NMec (%d) <= 999999, 1 <= P (%d) <= %d)\n",NMec,P,MAX_P);
+    exit(1);
+  }
+  t = wall_time();
+  fp = fopen(csv_name,"r");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"Unable to open file %s\n",csv_name);
+    exit(1);
+  }
+  memset(&header,0,sizeof(header));
+  memcpy(header.magic,INSTANCE_MAGIC,sizeof(header.magic));
+  header.NMec = NMec;
+  header.P = P;
+  max_tasks = 1024;
+  task = (task_t *)malloc((size_t)max_tasks * sizeof(task_t));
+  if(task == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  //
+  // one task per line (empty lines and lines starting with # are skipped, and so is a first line that is not a task)
+  //
+  sorted = 1;
+  header_line = 0;
+  for(n_lines = 1;fgets(line,sizeof(line),fp) != NULL;n_lines++)
+  {
+    if(strchr(line,'\n') == NULL && feof(fp) == 0)
+    {
+      fprintf(stderr,"%s:%d: line too long\n",csv_name,n_lines);
+      exit(1);
+    }
+    for(p = line;*p == ' ' || *p == '\t';p++)
+      ;
+    if(*p == '\0' || *p == '\n' || *p == '\r' || *p == '#')
+      continue;
+    for(k = 0;k < 3;k++)
+    {
+      v[k] = strtoll(p,&q,10);
+      if(q == p)
+        break;
+      for(p = q;*p == ' ' || *p == '\t';p++)
+        ;
+      if(k < 2 && *p++ != ',')
+        break;
+    }
+    if(k < 3 || (*p != '\0' && *p != '\n' && *p != '\r'))
+    {
+      if(header.T == 0 && header_line++ == 0)
+        continue;
+      fprintf(stderr,"%s:%d: expected starting_date,ending_date,profit\n",csv_name,n_lines);
+      exit(1);
+    }
+    if(v[0] < 0 || v[1] < v[0] || v[1] >= (long long)INT_MAX || v[2] < 0 || v[2] > (long long)INT_MAX)
+    {
+      fprintf(stderr,"%s:%d: bad task (0 <= starting_date <= ending_date < %d, 0 <= profit <= %d)\n",csv_name,n_lines,
+              INT_MAX,INT_MAX);
+      exit(1);
+    }
+    if(header.T == FILE_MAX_T)
+    {
+      fprintf(stderr,"%s: too many tasks (more than %d)\n",csv_name,FILE_MAX_T);
+      exit(1);
+    }
+    if(header.T == max_tasks)
+    {
+      max_tasks = (max_tasks <= FILE_MAX_T / 2) ? 2 * max_tasks : FILE_MAX_T;
+      task = (task_t *)realloc(task,(size_t)max_tasks * sizeof(task_t));
+      if(task == NULL)
+      {
+        fprintf(stderr,"Strange! Unable to allocate memory\n");
+        exit(1);
+      }
+    }
+    task[header.T].starting_date = (int)v[0];
+    task[header.T].ending_date = (int)v[1];
+    task[header.T].profit = (int)v[2];
+    task[header.T].assigned_to = -1;
+    task[header.T].best_assigned_to = -1;
+    if(header.T > 0 && compare_tasks(&task[header.T - 1],&task[header.T]) > 0)
+      sorted = 0;
+    if(task[header.T].ending_date > header.total_span)
+      header.total_span = task[header.T].ending_date;
+    header.T++;
+  }
+  if(ferror(fp) != 0 || fclose(fp) != 0 || header.T == 0)
+  {
+    fprintf(stderr,"%s: read error or no tasks\n",csv_name);
+    exit(1);
+  }
+  if(sorted == 0)
+    qsort((void *)task,(size_t)header.T,sizeof(task[0]),compare_tasks);
+  //
+  // the instance file has the name of the CSV file with the extension .bin
+  //
+  bin_name = (char *)malloc(strlen(csv_name) + 5);
+  if(bin_name == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  strcpy(bin_name,csv_name);
+  p = strrchr(bin_name,'.');
+  if(p == NULL || strchr(p,'/') != NULL)
+    p = bin_name + strlen(bin_name);
+  strcpy(p,".bin");
+  if(strcmp(bin_name,csv_name) == 0)
+  {
+    fprintf(stderr,"The CSV file %s cannot have the extension .bin\n",csv_name);
+    exit(1);
+  }
+  fp = fopen(bin_name,"wb");
+  if(fp == NULL)
+  {
+    fprintf(stderr,"Unable to create file %s\n",bin_name);
+    exit(1);
+  }
+  (void)fwrite(&header,sizeof(header),(size_t)1,fp);
+  (void)fwrite(task,sizeof(task[0]),(size_t)header.T,fp);
+  if(fflush(fp) != 0 || ferror(fp) != 0 || fclose(fp) != 0)
+  {
+    fprintf(stderr,"Error while writing data to file %s\n",bin_name);
+    exit(1);
+  }
+  printf("%s: NMec=%d T=%d P=%d I=%d, dates 0..%d, %.3f seconds\n",bin_name,NMec,header.T,P,header.I,
+         header.total_span,wall_time() - t);
+  free(bin_name);
+  free(task);
+}
+
+static long long single_programmer_profit(const task_t *task,int T)
+{ // the best profit of a single programmer (the tasks are sorted by starting date)
+  long long *best,profit;
+  int i,lo,hi;
+
+  best = (long long *)malloc((size_t)(T + 1) * sizeof(long long));
+  if(best == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  best[T] = 0;
+  for(i = T - 1;i >= 0;i--)
+  {
+    for(lo = i + 1,hi = T;lo < hi;) // the first task that starts after the end of task i
+      if(task[(lo + hi) / 2].starting_date > task[i].ending_date)
+        hi = (lo + hi) / 2;
+      else
+        lo = (lo + hi) / 2 + 1;
+    best[i] = (long long)task[i].profit + best[lo];
+    if(best[i] < best[i + 1])
+      best[i] = best[i + 1];
+  }
+  profit = best[0];
+  free(best);
+  return profit;
+}
+
+static void compress_dates(task_t *task,int T)
+{ // replaces the dates by their ranks (the tasks must be sorted by starting date); only changed dates are written
+  int i,j,lo,hi,rank,date,*end,*end_rank;
+
+  end = (int *)malloc((size_t)T * 2 * sizeof(int));
+  if(end == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  end_rank = end + T;
+  for(i = 0;i < T;i++)
+    end[i] = task[i].ending_date;
+  qsort((void *)end,(size_t)T,sizeof(int),compare_ints);
+  //
+  // merge the (sorted) starting dates with the sorted ending dates; equal dates get the same rank
+  //
+  rank = -1;
+  date = -1; // the dates are >= 0
+  for(i = j = 0;i < T || j < T;)
+    if(j == T || (i < T && task[i].starting_date <= end[j]))
+    {
+      if(task[i].starting_date != date)
+      {
+        date = task[i].starting_date;
+        rank++;
+      }
+      if(task[i].starting_date != rank)
+        task[i].starting_date = rank;
+      i++;
+    }
+    else
+    {
+      if(end[j] != date)
+      {
+        date = end[j];
+        rank++;
+      }
+      end_rank[j++] = rank;
+    }
+  for(i = 0;i < T;i++)
+  {
+    for(lo = 0,hi = T - 1;lo < hi;) // the first (sorted) ending date equal to the one of task i
+      if(end[(lo + hi) / 2] < task[i].ending_date)
+        lo = (lo + hi) / 2 + 1;
+      else
+        hi = (lo + hi) / 2;
+    if(task[i].ending_date != end_rank[lo])
+      task[i].ending_date = end_rank[lo];
+  }
+  free(end);
+}
+
+static void load_instance(const char *file_name,int P,int ignore_profit,problem_t *problem)
+{ // P < 1 means the P of the file
+  instance_header_t header;
+  struct stat file_stat;
+  long long sum;
+  int i,sorted;
+  task_t *task;
+#ifndef _WIN32
+  void *map;
+  int fd;
+#else
+  FILE *fp;
+#endif
+
+  if(stat(file_name,&file_stat) != 0)
+  {
+    fprintf(stderr,"Unable to open file %s\n",file_name);
+    exit(1);
+  }
+  if((size_t)file_stat.st_size < sizeof(instance_header_t))
+  {
+    fprintf(stderr,"%s is not an instance file\n",file_name);
+    exit(1);
+  }
+#ifndef _WIN32
+  fd = open(file_name,O_RDONLY);
+  if(fd < 0)
+  {
+    fprintf(stderr,"Unable to open file %s\n",file_name);
+    exit(1);
+  }
+  map = mmap(NULL,(size_t)file_stat.st_size,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0);
+  (void)close(fd);
+  if(map == MAP_FAILED)
+  {
+    fprintf(stderr,"Unable to map file %s in memory\n",file_name);
+    exit(1);
+  }
+  memcpy(&header,map,sizeof(header));
+#else
+  fp = fopen(file_name,"rb");
+  if(fp == NULL || fread(&header,sizeof(header),(size_t)1,fp) != (size_t)1)
+  {
+    fprintf(stderr,"Unable to read file %s\n",file_name);
+    exit(1);
+  }
+#endif
+  //
+  // header
+  //
+  if(memcmp(header.magic,INSTANCE_MAGIC,sizeof(header.magic)) != 0 || header.T < 1 || header.T > FILE_MAX_T ||
+     (size_t)file_stat.st_size != sizeof(instance_header_t) + (size_t)header.T * sizeof(task_t))
+  {
+    fprintf(stderr,"%s is not an instance file (or it was truncated)\n",file_name);
+    exit(1);
+  }
+  if(P < 1)
+    P = header.P;
+  if(P < 1 || P > MAX_P)
+  {
+    fprintf(stderr,"Bad P (1 <= P (%d) <= %d)\n",P,MAX_P);
+    exit(1);
+  }
+  problem->NMec = header.NMec;
+  problem->T = header.T;
+  problem->P = P;
+  problem->I = (ignore_profit == 0 && header.I == 0) ? 0 : 1;
+#ifndef _WIN32
+  problem->mapping = map;
+  problem->mapping_size = (size_t)file_stat.st_size;
+  task = (task_t *)((char *)map + sizeof(header));
+#else
+  // no mmap(): the tasks are read into allocated memory (released by free_problem())
+  problem->mapping = NULL;
+  problem->mapping_size = 0;
+  task = (task_t *)malloc((size_t)header.T * sizeof(task_t));
+  if(task == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+  if(fread(task,sizeof(task_t),(size_t)header.T,fp) != (size_t)header.T || fclose(fp) != 0)
+  {
+    fprintf(stderr,"Unable to read file %s\n",file_name);
+    exit(1);
+  }
+#endif
+  problem->task = task;
+  //
+  // tasks (only the pages with something to change are written, and so copied)
+  //
+  sorted = 1;
+  sum = 0;
+  for(i = 0;i < problem->T;i++)
+  {
+    if(task[i].starting_date < 0 || task[i].ending_date < task[i].starting_date || task[i].ending_date == INT_MAX ||
+       task[i].profit < 0)
+    {
+      fprintf(stderr,"%s: bad task %d (%d %d %d)\n",file_name,i,task[i].starting_date,task[i].ending_date,
+              task[i].profit);
+      exit(1);
+    }
+    if(i > 0 && compare_tasks(&task[i - 1],&task[i]) > 0)
+      sorted = 0;
+    if(problem->I != 0 && task[i].profit != 1)
+      task[i].profit = 1;
+    if(task[i].assigned_to != -1 || task[i].best_assigned_to != -1)
+      task[i].assigned_to = task[i].best_assigned_to = -1;
+    sum += (long long)task[i].profit;
+  }
+  if(sorted == 0)
+    qsort((void *)task,(size_t)problem->T,sizeof(task[0]),compare_tasks);
+  if(sum > (long long)INT_MAX && (long long)P * single_programmer_profit(task,problem->T) > (long long)INT_MAX)
+  {
+    fprintf(stderr,"%s: the profit of a solution may not fit in an int (ignore the profits, or scale them down)\n",
+            file_name);
+    exit(1);
+  }
+  compress_dates(task,problem->T);
+  //
+  // the other arrays of the problem
+  //
+  problem->busy = (int *)malloc((size_t)P * sizeof(int));
+  problem->suffix_bound = (int *)malloc((size_t)(problem->T + 1) * sizeof(int));
+  if(problem->busy == NULL || problem->suffix_bound == NULL)
+  {
+    fprintf(stderr,"Strange! Unable to allocate memory\n");
+    exit(1);
+  }
+#ifdef SEARCH_STATS
+  problem->stats = NULL;
+#endif
+  set_file_names(problem);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// main program
+//
+
+static int find_solver(char *name)
+{
+  int S;
+
+  for(S = 0;S < N_SOLVERS;S++)
+    if(strcmp(name,solvers[S].name) == 0)
+      return S;
+  fprintf(stderr,"Bad solver %s; use one of",name);
+  for(S = 0;S < N_SOLVERS;S++)
+    fprintf(stderr," %s",solvers[S].name);
+  fprintf(stderr,"\n");
+  exit(1);
+}
+
+int main(int argc,char **argv)
+{
+  problem_t problem;
+  int NMec,T,P,I,S,i,n_args,n_threads,split_depth,inner_solver,dominance,feasible_sampling,random_start,batch,resume;
+  int measure,incremental,top_k;
+  char *generate,*load,*import;
+  long long n_samples;
+  double time_budget,checkpoint_interval,deadline;
+  long n_cores;
+#ifdef _WIN32
+  SYSTEM_INFO system_info;
+#endif
+
+  //
+  // options (-name value, anywhere in the command line); what remains is NMec T P I solver
+  //
+#ifdef _WIN32
+  GetSystemInfo(&system_info);
+  n_cores = (long)system_info.dwNumberOfProcessors;
+#else
+  n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  n_threads = (n_cores < 1) ? 1 : (int)n_cores;
+  split_depth = 0;
+  dominance = 0;
+  n_samples = 2000000ll;
+  time_budget = 0.0;
+  feasible_sampling = 0;
+  random_start = 0;
+  batch = 0;
+  measure = 0;
+  incremental = 0;
+  top_k = DEFAULT_TOP_K;
+  generate = NULL;
+  load = NULL;
+  import = NULL;
+  checkpoint_interval = 60.0;
+  deadline = 0.0;
+  resume = 0;
+  inner_solver = find_solver("generate_possibilities");
+  for(i = n_args = 1;i < argc;i++)
+    if(strcmp(argv[i],"-threads") == 0 && i + 1 < argc)
+      n_threads = atoi(argv[++i]);
+    else if(strcmp(argv[i],"-depth") == 0 && i + 1 < argc)
+      split_depth = atoi(argv[++i]);
+    else if(strcmp(argv[i],"-inner") == 0 && i + 1 < argc)
+      inner_solver = find_solver(argv[++i]);
+    else if(strcmp(argv[i],"-dominance") == 0)
+      dominance = 1;
+    else if(strcmp(argv[i],"-samples") == 0 && i + 1 < argc)
+      n_samples = atoll(argv[++i]);
+    else if(strcmp(argv[i],"-time") == 0 && i + 1 < argc)
+      time_budget = atof(argv[++i]);
+    else if(strcmp(argv[i],"-feasible") == 0)
+      feasible_sampling = 1;
+    else if(strcmp(argv[i],"-random_start") == 0)
+      random_start = 1;
+    else if(strcmp(argv[i],"-deadline") == 0 && i + 1 < argc)
+      deadline = atof(argv[++i]);
+    else if(strcmp(argv[i],"-top") == 0 && i + 1 < argc)
+      top_k = atoi(argv[++i]);
+    else if(strcmp(argv[i],"-checkpoint") == 0 && i + 1 < argc)
+      checkpoint_interval = atof(argv[++i]);
+    else if(strcmp(argv[i],"-resume") == 0 || strcmp(argv[i],"--resume") == 0)
+      resume = 1;
+    else if(strcmp(argv[i],"-batch") == 0)
+      batch = 1; // the NMec, T and P arguments become a list of student numbers and two ranges
+    else if(strcmp(argv[i],"-measure") == 0)
+      measure = 1; // as -batch, but all solvers are timed (the solver argument is ignored)
+    else if(strcmp(argv[i],"-incremental") == 0)
+      incremental = 1; // requests read from the standard input (the P argument is the initial number of programmers)
+    else if(strcmp(argv[i],"-generate") == 0 && i + 1 < argc)
+      generate = argv[++i]; // the instance NMec T P I is written to this file (the solver argument is ignored)
+    else if(strcmp(argv[i],"-load") == 0 && i + 1 < argc)
+      load = argv[++i]; // instance file (the arguments become P I solver, and P = 0 means the P of the file)
+    else if(strcmp(argv[i],"-import") == 0 && i + 1 < argc)
+      import = argv[++i]; // this CSV file is converted to an instance file (the arguments become NMec P)
+    else
+      argv[n_args++] = argv[i];
+  argc = n_args;
+  if(n_threads < 1 || n_threads > 1024)
+  {
+    fprintf(stderr,"Bad number of threads (1 <= threads (%d) <= 1024)\n",n_threads);
+    exit(1);
+  }
+  if(top_k < 1 || top_k > 1000000)
+  {
+    fprintf(stderr,"Bad number of subsets (1 <= top (%d) <= 1000000)\n",top_k);
+    exit(1);
+  }
+  if(n_samples < 0 && time_budget <= 0.0)
+  {
+    fprintf(stderr,"The parallel sampler needs a sample budget (-samples) or a time budget (-time)\n");
+    exit(1);
+  }
+  NMec = (argc < 2 || batch != 0 || measure != 0) ? 2020 : atoi(argv[1]);
+  T = (argc < 3 || batch != 0 || measure != 0) ? 5 : atoi(argv[2]);
+  P = (argc < 4 || batch != 0 || measure != 0) ? 2 : atoi(argv[3]);
+  I = (argc < 5) ? 0 : atoi(argv[4]);
+  S = (argc < 6) ? DEFAULT_SOLVER : find_solver(argv[5]);
+  if(import != NULL)
+  {
+    import_csv(import,(argc < 2) ? 2020 : atoi(argv[1]),(argc < 3) ? 1 : atoi(argv[2]));
+    return 0;
+  }
+  if(generate != NULL)
+  {
+    generate_instance(NMec,T,P,I,generate);
+    return 0;
+  }
+  if(incremental != 0)
+  {
+    incremental_driver(stdin,(argc < 4) ? 1 : P);
+    return 0;
+  }
+  problem.solver = S;
+  problem.n_threads = n_threads;
+  problem.split_depth = split_depth;
+  problem.inner_solver = inner_solver;
+  problem.dominance = dominance;
+  problem.n_samples = (n_samples < 0) ? -1 : n_samples;
+  problem.time_budget = time_budget;
+  problem.feasible_sampling = feasible_sampling;
+  problem.random_start = random_start;
+  problem.batch = 0;
+  problem.checkpoint_interval = checkpoint_interval;
+  problem.resume = resume;
+  problem.deadline = deadline;
+  problem.top_k = top_k;
+  if(load != NULL)
+  {
+    problem.solver = (argc < 4) ? DEFAULT_SOLVER : find_solver(argv[3]);
+    load_instance(load,(argc < 2) ? 0 : atoi(argv[1]),(argc < 3) ? 0 : atoi(argv[2]),&problem);
+    solve(&problem);
+    free_problem(&problem);
+    return 0;
+  }
+  if(batch != 0)
+  {
+    if(argc < 4)
+    {
+      fprintf(stderr,"usage: %s -batch NMec1,NMec2,... T1..T2 P1..P2 [I [solver]]\n",argv[0]);
+      exit(1);
+    }
+    batch_sweep(argv[1],argv[2],argv[3],I,&problem);
+    return 0;
+  }
+  if(measure != 0)
+  {
+    if(argc < 4)
+    {
+      fprintf(stderr,"usage: %s -measure NMec1,NMec2,... T1..T2 P1..P2 [I]\n",argv[0]);
+      exit(1);
+    }
+    measure_solvers(argv[1],argv[2],argv[3],I,&problem);
+    return 0;
+  }
   init_problem(NMec,T,P,I,&problem);
   solve(&problem);
+  free_problem(&problem);
   return 0;
 }
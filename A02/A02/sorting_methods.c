@@ -10,6 +10,9 @@
 //      > make sorting_methods
 //      > ./sorting_methods -measure | tee output.txt
 //      The program will take some time to finish (somewhere between 1 hour and 4 hours)
+//      The data is random; "-measure sorted", "-measure reversed" and "-measure killer" (an input that makes the
+//      median of three of quick_sort always choose the second smallest item) use other inputs, and any further
+//      arguments select the sorting routines to measure (for example, "-measure killer quick_sort intro_sort")
 //   2. (highly recommended)
 //      Read and understand the code of the main function.
 //   2. (mandatory)
@@ -28,6 +31,49 @@
 #include "sorting_methods.h"
 #include "../P02/elapsed_time.h"
 
+//
+// input data for -measure
+//
+
+static void median_of_three_killer(T *data,int *id,int n)
+{ // replay the partitions of quick_sort() on the positions of the items (id[k] is the initial position of the item at
+  // position k), choosing the values on the way: the first and last items get the two smallest values not yet used,
+  // so they are the median of three (the middle item has not been given a value yet, so it is larger); only these
+  // two items leave the larger part, that is then partitioned in the same way (n/2 levels of recursion)
+  int i,first,v,tmp;
+
+  for(i = 0;i < n;i++)
+    id[i] = i;
+  v = 0;
+  for(first = 0;n - first >= 20;first += 2)
+  {
+    data[id[first]] = (T)v++;     // goes to the "smaller part"
+    data[id[n - 1]] = (T)v++;     // the pivot
+    tmp = id[first + 1];          // the pivot is swapped with the first item of the "larger part"
+    id[first + 1] = id[n - 1];
+    id[n - 1] = tmp;
+  }
+  for(i = first;i < n;i++)
+    data[id[i]] = (T)v++;
+}
+
+static void make_data(char *input,T *data,int *aux,int n)
+{
+  int j;
+
+  if(strcmp(input,"sorted") == 0)
+    for(j = 0;j < n;j++)
+      data[j] = (T)j;
+  else if(strcmp(input,"reversed") == 0)
+    for(j = 0;j < n;j++)
+      data[j] = (T)(n - j);
+  else if(strcmp(input,"killer") == 0)
+    median_of_three_killer(data,aux,n);
+  else
+    for(j = 0;j < n;j++)
+      data[j] = (T)rand();
+}
+
 void show(T *data,int first,int one_after_last)
 {
   int i;
@@ -54,6 +100,7 @@ int main(int argc,char *argv[argc])
     EXPAND(insertion_sort),
     EXPAND(Shell_sort),
     EXPAND(quick_sort),
+    EXPAND(intro_sort),
     EXPAND(merge_sort),
     EXPAND(heap_sort),
     EXPAND(rank_sort),
@@ -124,7 +171,7 @@ int main(int argc,char *argv[argc])
   //
   // measure the cpu time of all sorting routines
   //
-  if(argc == 2 && strcmp(argv[1],"-measure") == 0)
+  if(argc >= 2 && strcmp(argv[1],"-measure") == 0)
   {
 # define MAX_N          10000000  // largest array size
 # define N_MEASUREMENTS     1000  // number of measurements to perform for each value of n
@@ -132,17 +179,34 @@ int main(int argc,char *argv[argc])
 # define MAX_TIME           500.0  // maximum amount of time, in seconds, spent in a value of n
     double v,w,t[N_MEASUREMENTS + 2 * N_EXTRA];
     int f_idx,n_idx,n,i,j;
+    char *input;
+    int *aux;
     T *data;
 
+    input = (argc >= 3) ? argv[2] : "random";
+    if(strcmp(input,"random") != 0 && strcmp(input,"sorted") != 0 && strcmp(input,"reversed") != 0 &&
+       strcmp(input,"killer") != 0)
+    {
+      fprintf(stderr,"unknown input %s (use random, sorted, reversed, or killer) --- 😒\n",input);
+      exit(1);
+    }
     data = (T *)malloc((size_t)MAX_N * sizeof(T));
-    if(data == NULL)
+    aux = (int *)malloc((size_t)MAX_N * sizeof(int));
+    if(data == NULL || aux == NULL)
     {
       fprintf(stderr,"unable to allocate memory for the data array --- 😒\n");
       exit(1);
     }
     for(f_idx = 0;f_idx < N_FUNCTIONS;f_idx++)
     {
-      printf("# %s\n",functions[f_idx].name);
+      for(i = 3;i < argc && strcmp(argv[i],functions[f_idx].name) != 0;i++)
+        ;
+      if(argc > 3 && i == argc)
+        continue; // not selected
+      if(strcmp(input,"random") == 0)
+        printf("# %s\n",functions[f_idx].name);
+      else
+        printf("# %s (%s input)\n",functions[f_idx].name,input);
       printf("#      n  min time  max time  avg time   std dev\n");
       printf("#------- --------- --------- --------- ---------\n");
       for(n_idx = 10;n_idx <= 80;n_idx++)
@@ -155,8 +219,7 @@ int main(int argc,char *argv[argc])
           srand((unsigned int)n_idx); // make sure are sorting routines receive the same data
           for(i = 0;i < N_MEASUREMENTS + 2 * N_EXTRA;i++)
           {
-            for(j = 0;j < n;j++)
-              data[j] = (T)rand();
+            make_data(input,data,aux,n);
             v = cpu_time();
             (*functions[f_idx].function)(data,0,n);
             v = cpu_time() - v;
@@ -184,6 +247,7 @@ int main(int argc,char *argv[argc])
       fflush(stdout);
     }
     free(data);
+    free(aux);
     return 0;
 # undef MAX_N
 # undef N_MEASUREMENTS
@@ -195,5 +259,6 @@ int main(int argc,char *argv[argc])
   //
   fprintf(stderr,"usage: %s -test     # test all sorting routines\n",argv[0]);
   fprintf(stderr,"       %s -measure  # measure the cpu time of all sorting routines\n",argv[0]);
+  fprintf(stderr,"       %s -measure random|sorted|reversed|killer [name ...]  # same, other inputs or routines\n",argv[0]);
   return 1;
 }
@@ -14,6 +14,7 @@ void shaker_sort   (T *data,int first,int one_after_last);
 void insertion_sort(T *data,int first,int one_after_last);
 void Shell_sort    (T *data,int first,int one_after_last);
 void quick_sort    (T *data,int first,int one_after_last);
+void intro_sort    (T *data,int first,int one_after_last);
 void merge_sort    (T *data,int first,int one_after_last);
 void heap_sort     (T *data,int first,int one_after_last);
 void rank_sort     (T *data,int first,int one_after_last);